@@ -0,0 +1,133 @@
+#include "batch.h"
+#include "predicates.h"
+#include <cmath>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BATCH_AVX2
+#include <immintrin.h>
+#endif
+
+double angle_key(const Point& orthocenter) {
+	const double x2 = orthocenter.x * orthocenter.x;
+	return std::abs(orthocenter.x) < EPS ? 0.0 : x2 / (x2 + orthocenter.y * orthocenter.y);
+}
+
+double angle_key(double angle) {
+	const double sin_a = std::sin(angle);
+	return sin_a * sin_a;
+}
+
+// Line(B, C).perpendicular(A) and Line(C, A).perpendicular(B) intersected, spelled out
+static void orthocenter_one(
+	const Point& A, const Point& B, const Point& C,
+	double& hx, double& hy, double& key, unsigned char& collinear
+) {
+	const double delta = orient2d(A, B, C);
+	collinear = delta == 0;
+
+	const double a1 = B.y - C.y;
+	const double b1 = C.x - B.x;
+	const double c1 = -(b1 * A.x - a1 * A.y);
+	const double a2 = C.y - A.y;
+	const double b2 = A.x - C.x;
+	const double c2 = -(b2 * B.x - a2 * B.y);
+
+	const Point h((c1 * a2 - a1 * c2) / delta, (c1 * b2 - b1 * c2) / delta);
+	hx = h.x;
+	hy = h.y;
+	key = angle_key(h);
+}
+
+static void orthocenter_scalar(
+	const Point& A, const Point& B,
+	const double *cx, const double *cy, size_t count,
+	double *hx, double *hy, double *key, unsigned char *collinear
+) {
+	for (size_t k = 0; k != count; ++k)
+		orthocenter_one(A, B, Point(cx[k], cy[k]), hx[k], hy[k], key[k], collinear[k]);
+}
+
+#ifdef BATCH_AVX2
+
+// The orient2d filter is evaluated for 4 lanes at once; lanes it can not settle are redone by orthocenter_one.
+__attribute__((target("avx2")))
+static size_t orthocenter_avx2(
+	const Point& A, const Point& B,
+	const double *cx, const double *cy, size_t count,
+	double *hx, double *hy, double *key, unsigned char *collinear
+) {
+	const __m256d vax = _mm256_set1_pd(A.x);
+	const __m256d vay = _mm256_set1_pd(A.y);
+	const __m256d vbx = _mm256_set1_pd(B.x);
+	const __m256d vby = _mm256_set1_pd(B.y);
+	const __m256d sign = _mm256_set1_pd(-0.0);
+	const __m256d eps = _mm256_set1_pd(EPS);
+	const __m256d zero = _mm256_setzero_pd();
+	const __m256d errbound = _mm256_set1_pd(ORIENT2D_ERRBOUND);
+
+	size_t k = 0;
+	for (; k + 4 <= count; k += 4) {
+		const __m256d vcx = _mm256_loadu_pd(cx + k);
+		const __m256d vcy = _mm256_loadu_pd(cy + k);
+
+		const __m256d a1 = _mm256_sub_pd(vby, vcy);
+		const __m256d b1 = _mm256_sub_pd(vcx, vbx);
+		const __m256d c1 = _mm256_xor_pd(sign, _mm256_sub_pd(_mm256_mul_pd(b1, vax), _mm256_mul_pd(a1, vay)));
+		const __m256d a2 = _mm256_sub_pd(vcy, vay);
+		const __m256d b2 = _mm256_sub_pd(vax, vcx);
+		const __m256d c2 = _mm256_xor_pd(sign, _mm256_sub_pd(_mm256_mul_pd(b2, vbx), _mm256_mul_pd(a2, vby)));
+
+		// detleft - detright of orient2d(A, B, C)
+		const __m256d detleft = _mm256_mul_pd(a1, b2);
+		const __m256d detright = _mm256_mul_pd(b1, a2);
+		const __m256d delta = _mm256_sub_pd(detleft, detright);
+		const __m256d bound = _mm256_mul_pd(errbound, _mm256_add_pd(_mm256_andnot_pd(sign, detleft), _mm256_andnot_pd(sign, detright)));
+		const int uncertain = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_andnot_pd(sign, delta), bound, _CMP_LT_OQ));
+		const int mask = _mm256_movemask_pd(_mm256_cmp_pd(delta, zero, _CMP_EQ_OQ));
+		for (int lane = 0; lane != 4; ++lane)
+			collinear[k + lane] = (mask >> lane) & 1;
+
+		const __m256d x = _mm256_div_pd(_mm256_sub_pd(_mm256_mul_pd(c1, a2), _mm256_mul_pd(a1, c2)), delta);
+		const __m256d y = _mm256_div_pd(_mm256_sub_pd(_mm256_mul_pd(c1, b2), _mm256_mul_pd(b1, c2)), delta);
+		_mm256_storeu_pd(hx + k, x);
+		_mm256_storeu_pd(hy + k, y);
+
+		const __m256d x2 = _mm256_mul_pd(x, x);
+		const __m256d ratio = _mm256_div_pd(x2, _mm256_add_pd(x2, _mm256_mul_pd(y, y)));
+		const __m256d on_axis = _mm256_cmp_pd(_mm256_andnot_pd(sign, x), eps, _CMP_LT_OQ);
+		_mm256_storeu_pd(key + k, _mm256_blendv_pd(ratio, zero, on_axis));
+
+		for (int lane = 0; uncertain && lane != 4; ++lane)
+			if ((uncertain >> lane) & 1)
+				orthocenter_one(A, B, Point(cx[k + lane], cy[k + lane]), hx[k + lane], hy[k + lane], key[k + lane], collinear[k + lane]);
+	}
+	return k;
+}
+
+#endif // BATCH_AVX2
+
+bool batch_vectorized() {
+#ifdef BATCH_AVX2
+	static const bool avx2 = __builtin_cpu_supports("avx2");
+	return avx2;
+#else
+	return false;
+#endif
+}
+
+void orthocenter_batch(
+	const Point& A, const Point& B,
+	const double *cx, const double *cy, size_t count,
+	double *hx, double *hy, double *key, unsigned char *collinear
+) {
+	size_t done = 0;
+#ifdef BATCH_AVX2
+	if (batch_vectorized())
+		done = orthocenter_avx2(A, B, cx, cy, count, hx, hy, key, collinear);
+#endif
+	orthocenter_scalar(
+		A, B,
+		cx + done, cy + done, count - done,
+		hx + done, hy + done, key + done, collinear + done
+	);
+}
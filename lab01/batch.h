@@ -0,0 +1,24 @@
+#ifndef BATCH_H_
+#define BATCH_H_
+
+#include <cstddef>
+#include "geometry.h"
+
+// sin^2 of orthocenter_angle: monotone in the angle and cheap to vectorize, 0 where the angle is 0
+double angle_key(const Point& orthocenter);
+double angle_key(double angle);
+
+// Triangles (A, B, C[k]), k in [0, count), with C given as coordinate arrays cx, cy.
+// For each triangle writes the orthocenter (hx, hy), its angle_key and whether on_one_line(A, B, C) holds;
+// hx, hy and key are unspecified for collinear triangles.
+// The orthocenter is computed with the same operations as Triangle::orthocenter, so results are equal bit for bit.
+// Uses AVX2 (4 triangles per instruction) when the CPU has it.
+void orthocenter_batch(
+	const Point& A, const Point& B,
+	const double *cx, const double *cy, size_t count,
+	double *hx, double *hy, double *key, unsigned char *collinear
+);
+
+bool batch_vectorized();
+
+#endif // BATCH_H_
@@ -0,0 +1,29 @@
+#-------------------------------------------------
+#
+# Headless lab01 solver: no Qt, no MainWindow
+#
+#-------------------------------------------------
+
+TARGET = lab01-cli
+TEMPLATE = app
+CONFIG += console c++11 thread
+CONFIG -= app_bundle qt
+
+INCLUDEPATH += ..
+
+SOURCES += \
+        main.cpp \
+        ../geometry.cpp \
+        ../search.cpp \
+        ../batch.cpp \
+        ../predicates.cpp \
+        ../dedup.cpp \
+        ../pointset.cpp
+
+HEADERS += \
+        ../geometry.h \
+        ../search.h \
+        ../batch.h \
+        ../predicates.h \
+        ../dedup.h \
+        ../pointset.h
@@ -0,0 +1,84 @@
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include "geometry.h"
+#include "pointset.h"
+#include "search.h"
+
+static void usage(const char *name) {
+	std::cerr << "Usage: " << name << " [--binary] [--threads N] [FILE]\n"
+	          << "Reads \"x y\" pairs from FILE (standard input by default) or, with --binary,\n"
+	          << "native double pairs, and finds the triangle whose orthocenter makes\n"
+	          << "the greatest angle with the y axis.\n";
+}
+
+int main(int argc, char *argv[])
+{
+	bool binary = false;
+	unsigned threads = 0;
+	const char *path = 0;
+	for (int i = 1; i < argc; ++i) {
+		if (!std::strcmp(argv[i], "--binary"))
+			binary = true;
+		else if (!std::strcmp(argv[i], "--threads") && i + 1 < argc)
+			threads = std::atoi(argv[++i]);
+		else if (argv[i][0] == '-' && argv[i][1]) {
+			usage(argv[0]);
+			return 2;
+		}
+		else
+			path = argv[i];
+	}
+	if (binary && !path) {
+		usage(argv[0]);
+		return 2;
+	}
+
+	typedef std::chrono::steady_clock clock;
+	const clock::time_point start = clock::now();
+
+	std::vector<Point> points;
+	ReadStatus status;
+	if (binary)
+		status = read_points_binary(path, points);
+	else if (path) {
+		std::ifstream file(path);
+		if (!file)
+			status = READ_CANNOT_OPEN;
+		else
+			status = read_points(file, points) ? READ_OK : READ_INVALID;
+	}
+	else
+		status = read_points(std::cin, points) ? READ_OK : READ_INVALID;
+	if (status == READ_CANNOT_OPEN) {
+		std::cerr << "Cannot open " << path << '\n';
+		return 4;
+	}
+	if (status == READ_INVALID) {
+		std::cerr << "Invalid input after " << points.size() << " points\n";
+		return 1;
+	}
+
+	const clock::time_point read = clock::now();
+
+	TriangleSearch search(points);
+	const SearchResult result = search.run(threads);
+
+	const clock::time_point found = clock::now();
+
+	std::cout << "Points: " << points.size() << " (" << search.distinct() << " distinct)\n";
+	if (result.found()) {
+		std::cout << "Triangle: points " << result.i + 1 << ", " << result.j + 1 << " and " << result.k + 1 << ": "
+		          << Triangle(points[result.i], points[result.j], points[result.k]) << '\n'
+		          << "Orthocenter: " << result.orthocenter << '\n'
+		          << "Angle: " << degrees(result.angle) << '\n';
+	}
+	else
+		std::cout << "No one triangle can be drawn\n";
+	std::cout << "Read: " << std::chrono::duration<double>(read - start).count() << " s\n"
+	          << "Search: " << std::chrono::duration<double>(found - read).count() << " s\n";
+
+	return result.found() ? 0 : 3;
+}
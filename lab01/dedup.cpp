@@ -0,0 +1,51 @@
+#include "dedup.h"
+#include "predicates.h"
+#include <cstring>
+#include <unordered_map>
+
+namespace {
+
+// Coordinates compared as doubles, so the relation is transitive and does not depend on input
+// order; adding 0.0 turns -0 into +0, which compares equal to it, before the bits are hashed.
+struct Key {
+	double x, y;
+
+	bool operator==(const Key& other) const {
+		return x == other.x && y == other.y;
+	}
+};
+
+struct KeyHash {
+	size_t operator()(const Key& key) const {
+		unsigned long long x, y;
+		std::memcpy(&x, &key.x, sizeof x);
+		std::memcpy(&y, &key.y, sizeof y);
+		return std::hash<unsigned long long>()(x * 0x9E3779B97F4A7C15ULL ^ y);
+	}
+};
+
+}
+
+void deduplicate(const std::vector<Point>& points, std::vector<Point>& unique, std::vector<int>& origin) {
+	unique.clear();
+	origin.clear();
+
+	std::unordered_map<Key, int, KeyHash> first;
+	first.reserve(points.size());
+
+	for (size_t i = 0; i != points.size(); ++i) {
+		const Key key = { points[i].x + 0.0, points[i].y + 0.0 };
+		if (!first.insert(std::make_pair(key, static_cast<int>(unique.size()))).second)
+			continue;
+
+		unique.push_back(points[i]);
+		origin.push_back(i);
+	}
+}
+
+bool all_collinear(const std::vector<Point>& points) {
+	for (size_t k = 2; k < points.size(); ++k)
+		if (!on_one_line(points[0], points[1], points[k]))
+			return false;
+	return true;
+}
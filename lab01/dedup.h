@@ -0,0 +1,15 @@
+#ifndef DEDUP_H_
+#define DEDUP_H_
+
+#include <vector>
+#include "geometry.h"
+
+// Collapses points with exactly equal coordinates into the first of them, in O(n) expected time.
+// Points that are merely within EPS (operator==) stay apart: under the exact orient2d they still
+// form real triangles. The survivors keep their input order; origin[u] is the input index of
+// unique point u, so indices into `unique` map back to the user's numbering.
+void deduplicate(const std::vector<Point>& points, std::vector<Point>& unique, std::vector<int>& origin);
+
+bool all_collinear(const std::vector<Point>& points);
+
+#endif // DEDUP_H_
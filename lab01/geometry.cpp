@@ -1,4 +1,5 @@
 #include "geometry.h"
+#include "predicates.h"
 #include <cmath>
 #include <cassert>
 
@@ -46,7 +47,7 @@ double angle(const Point& A, const Point& B) {
 }
 
 bool on_one_line(const Point& A, const Point& B, const Point& C) {
-	return std::abs(skew_product(Point(A, B), Point(A, C))) < EPS;
+	return orient2d(A, B, C) == 0;
 }
 
 Point operator-(const Point& A, const Point& B) {
@@ -102,14 +103,19 @@ Line Line::perpendicular(const Point& point) const {
 	return Line(dv.x, dv.y, -(dv.x * point.x + dv.y * point.y));
 }
 
-Point intersection(const Line& a, const Line& b) {
-	double delta = a.A * b.B - a.B * b.A;
-	assert(std::abs(delta) > EPS);
+// delta is the determinant a.A * b.B - a.B * b.A, maybe computed more carefully by the caller
+static Point intersection(const Line& a, const Line& b, double delta) {
 	double delta_x = -a.C * b.B + a.B * b.C;
 	double delta_y = -a.A * b.C + a.C * b.A;
 	return Point(delta_x / delta, delta_y / delta);
 }
 
+Point intersection(const Line& a, const Line& b) {
+	double delta = a.A * b.B - a.B * b.A;
+	assert(std::abs(delta) > EPS);
+	return intersection(a, b, delta);
+}
+
 double angle(const Line& a, const Line& b) {
 	if (parallel(a, b))
 		return 0.0;
@@ -139,13 +145,14 @@ Triangle::Triangle(const Point& A, const Point& B, const Point& C) {
 Point Triangle::orthocenter() const {
 	Line AH1 = Line(B, C).perpendicular(A);
 	Line BH2 = Line(C, A).perpendicular(B);
-	return intersection(AH1, BH2);
+	// the determinant of the altitudes equals orient2d(A, B, C), which is never 0 for a triangle
+	return intersection(AH1, BH2, orient2d(A, B, C));
 }
 
 bool Triangle::includes(const Point &point) const {
-	double sgn_a = skew_product(Point(B, C), point);
-	double sgn_b = skew_product(Point(C, A), point);
-	double sgn_c = skew_product(Point(A, B), point);
+	double sgn_a = orient2d(B, C, point);
+	double sgn_b = orient2d(C, A, point);
+	double sgn_c = orient2d(A, B, point);
 
 	return (sgn_a >= 0 && sgn_b >= 0 && sgn_c >= 0)
 		|| (sgn_a <= 0 && sgn_b <= 0 && sgn_c <= 0);
@@ -4,12 +4,13 @@
 #
 #-------------------------------------------------
 
-QT       += core gui
+QT       += core gui concurrent
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
 TARGET = lab01
 TEMPLATE = app
+CONFIG += c++11
 
 # The following define makes your compiler emit warnings if you use
 # any feature of Qt which has been marked as deprecated (the exact warnings
@@ -26,11 +27,19 @@ DEFINES += QT_DEPRECATED_WARNINGS
 SOURCES += \
         main.cpp \
         mainwindow.cpp \
-        geometry.cpp
+        geometry.cpp \
+        search.cpp \
+        batch.cpp \
+        predicates.cpp \
+        dedup.cpp
 
 HEADERS += \
         mainwindow.h \
-        geometry.h
+        geometry.h \
+        search.h \
+        batch.h \
+        predicates.h \
+        dedup.h
 
 FORMS += \
         mainwindow.ui
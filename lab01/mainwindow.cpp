@@ -1,19 +1,25 @@
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
 
+#include <QtConcurrent>
+
 MainWindow::MainWindow(QWidget *parent)
 	: QMainWindow(parent)
 	, ui(new Ui::MainWindow)
 	, j_max(0)
+	, cancelRequested(false)
 {
 	ui->setupUi(this);
 
 	connect(ui->tableWidget, SIGNAL(itemChanged(QTableWidgetItem*)),
 	        this, SLOT(tableWidgetItem_changed(QTableWidgetItem*)));
+	connect(&searchWatcher, SIGNAL(finished()), this, SLOT(search_finished()));
+	connect(&progressTimer, SIGNAL(timeout()), this, SLOT(search_progress()));
 }
 
 MainWindow::~MainWindow()
 {
+	cancelSearch();
 	delete ui;
 }
 
@@ -39,8 +45,11 @@ void MainWindow::on_addPointPushButton_clicked()
 		return;
 	}
 
-	j_max = 0;
+	cancelSearch();
 	points.push_back(point);
+	invalidatePointsLayer();
+	ranking.point_added(points.toStdVector());
+	applyRanking();
 
 	int i = ui->tableWidget->rowCount();
 	ui->tableWidget->insertRow(i);
@@ -63,8 +72,11 @@ void MainWindow::on_deletePointPushButton_clicked()
 		return;
 	}
 
-	j_max = 0;
+	cancelSearch();
 	points.remove(i - 1);
+	invalidatePointsLayer();
+	ranking.point_removed(i - 1);
+	applyRanking();
 
 	ui->tableWidget->removeRow(i - 1);
 
@@ -92,15 +104,22 @@ void MainWindow::tableWidgetItem_changed(QTableWidgetItem *item)
 		return;
 	}
 
-	j_max = 0;
+	cancelSearch();
 	points[item->row()][item->column()] = coord;
+	invalidatePointsLayer();
+	ranking.point_changed(points.toStdVector(), item->row());
+	applyRanking();
 
 	ui->statusBar->showMessage("Point edited successful", STATUS_BAR_TIMEOUT);
 }
 
 void MainWindow::on_calculatePushButton_clicked()
 {
-	if (j_max) {
+	if (searchWatcher.isRunning()) {
+		ui->statusBar->showMessage("Already calculating", STATUS_BAR_TIMEOUT);
+		return;
+	}
+	if (ranking.valid()) {
 		ui->statusBar->showMessage("Already calculated", STATUS_BAR_TIMEOUT);
 		return;
 	}
@@ -109,22 +128,62 @@ void MainWindow::on_calculatePushButton_clicked()
 		return;
 	}
 
-	int i, j, k;
-	angle_max = -1;
-	Line y_axis(1, 0, 0);
-	for (i = 0; i < points.size() - 2; ++i)
-		for (j = i + 1; j < points.size() - 1; ++j)
-			for (k = j + 1; k < points.size(); ++k)
-				if (!on_one_line(points[i], points[j], points[k])) {
-					Point orthocenter = Triangle(points[i], points[j], points[k]).orthocenter();
-					double angle_cur = orthocenter == Point() ? 0.0 : angle(Line(orthocenter, Point()), y_axis);
-					if (angle_cur > angle_max) {
-						i_max = i, j_max = j, k_max = k;
-						orthocenter_max = orthocenter;
-						angle_max = angle_cur;
-					}
-				}
+	search.reset(new TriangleSearch(points.toStdVector()));
+	TriangleSearch *engine = search.data();
+	cancelRequested = false;
+	searchWatcher.setFuture(QtConcurrent::run([engine]() {
+		return engine->run(0, TriangleRanking::DEFAULT_CAPACITY);
+	}));
+
+	ui->cancelPushButton->setEnabled(true);
+	progressTimer.start(PROGRESS_INTERVAL);
+	search_progress();
+}
+
+void MainWindow::on_cancelPushButton_clicked()
+{
+	if (!searchWatcher.isRunning())
+		return;
+
+	search->cancel();
+	cancelRequested = true;
+	ui->statusBar->showMessage("Cancelling...");
+}
+
+void MainWindow::cancelSearch()
+{
+	if (!searchWatcher.isRunning())
+		return;
 
+	search->cancel();
+	searchWatcher.waitForFinished();
+}
+
+void MainWindow::search_progress()
+{
+	if (!searchWatcher.isRunning() || search->cancelled() || !search->total())
+		return;
+
+	ui->statusBar->showMessage(
+		"Calculating: "
+		+ QString::number(100.0 * search->done() / search->total(), 'f', 1) + "%"
+	);
+}
+
+void MainWindow::search_finished()
+{
+	progressTimer.stop();
+	ui->cancelPushButton->setEnabled(false);
+
+	// A search cancelled by a point edit ends silently: the edit has its own status message
+	if (search->cancelled()) {
+		if (cancelRequested)
+			ui->statusBar->showMessage("Calculation cancelled", STATUS_BAR_TIMEOUT);
+		return;
+	}
+
+	ranking = search->ranking();
+	applyRanking();
 	if (!j_max) {
 		ui->statusBar->showMessage("No one triangle can be drawn", STATUS_BAR_TIMEOUT);
 		return;
@@ -140,10 +199,29 @@ void MainWindow::on_calculatePushButton_clicked()
 	update();
 }
 
+// j_max stays 0 while there is no triangle to draw, either because there is none or
+// because the ranking ran dry and the next Calculate has to do a full search
+void MainWindow::applyRanking()
+{
+	const SearchResult result = ranking.best();
+	if (result.found()) {
+		i_max = result.i, j_max = result.j, k_max = result.k;
+		orthocenter_max = result.orthocenter;
+		angle_max = result.angle;
+	}
+	else
+		j_max = 0;
+
+	update();
+}
+
 void MainWindow::on_clearPushButton_clicked()
 {
+	cancelSearch();
 	j_max = 0;
 	points.clear();
+	invalidatePointsLayer();
+	ranking.clear();
 
 	while (ui->tableWidget->rowCount())
 		ui->tableWidget->removeRow(ui->tableWidget->rowCount() - 1);
@@ -197,17 +275,10 @@ void MainWindow::paintEvent(QPaintEvent *)
 	double scale_y = 0.9 * PAINT_HEIGHT / (y_max - y_min);
 	scale_factor = qMin(scale_x, scale_y);
 
-	// draw points
-	painter.setPen(Qt::red);
-	painter.setBrush(Qt::red);
-	foreach (const Point &point, points) {
-		double x = x_coord(point.x);
-		double y = y_coord(point.y);
-		if (0 <= x && x <= PAINT_WIDTH
-		 && 0 <= y && y <= PAINT_HEIGHT) {
-			painter.drawEllipse(x - 2, y - 2, 4, 4);
-		}
-	}
+	// axes and points come from the cache, only the result is drawn every time
+	updateLayers();
+	painter.drawPixmap(0, 0, axesLayer);
+	painter.drawPixmap(0, 0, pointsLayer);
 
 	// draw triangle
 	painter.setPen(QPen(Qt::green, 3));
@@ -272,8 +343,6 @@ void MainWindow::paintEvent(QPaintEvent *)
 		drawLine(Line(origin, orthocenter_max), painter);
 	const double x0 = x_coord(0);
 	const double y0 = y_coord(0);
-	if (0 <= x0 && x0 <= PAINT_WIDTH)
-		painter.drawLine(x0, 0, x0, PAINT_HEIGHT);
 	if (0 <= x0 && x0 <= PAINT_WIDTH
 	 && 0 <= y0 && y0 <= PAINT_HEIGHT) {
 		double startAngle, spanAngle;
@@ -290,6 +359,50 @@ void MainWindow::paintEvent(QPaintEvent *)
 	}
 }
 
+void MainWindow::invalidatePointsLayer()
+{
+	pointsLayer = QPixmap();
+}
+
+// Rasterizes the layers that depend only on the viewport and the points, whichever of them is stale
+void MainWindow::updateLayers()
+{
+	const QRectF viewport(x_min, y_min, x_max - x_min, y_max - y_min);
+	if (viewport != layersViewport) {
+		layersViewport = viewport;
+		axesLayer = QPixmap();
+		pointsLayer = QPixmap();
+	}
+
+	if (axesLayer.isNull()) {
+		axesLayer = QPixmap(PAINT_WIDTH, PAINT_HEIGHT);
+		axesLayer.fill(Qt::white);
+
+		QPainter painter(&axesLayer);
+		painter.setPen(QPen(Qt::gray, 1));
+		const double x0 = x_coord(0);
+		if (0 <= x0 && x0 <= PAINT_WIDTH)
+			painter.drawLine(x0, 0, x0, PAINT_HEIGHT);
+	}
+
+	if (pointsLayer.isNull()) {
+		pointsLayer = QPixmap(PAINT_WIDTH, PAINT_HEIGHT);
+		pointsLayer.fill(Qt::transparent);
+
+		QPainter painter(&pointsLayer);
+		painter.setPen(Qt::red);
+		painter.setBrush(Qt::red);
+		foreach (const Point &point, points) {
+			double x = x_coord(point.x);
+			double y = y_coord(point.y);
+			if (0 <= x && x <= PAINT_WIDTH
+			 && 0 <= y && y <= PAINT_HEIGHT) {
+				painter.drawEllipse(x - 2, y - 2, 4, 4);
+			}
+		}
+	}
+}
+
 void MainWindow::drawLine(const Line &line, QPainter &painter)
 {
 	const double dx = x_max - x_min;
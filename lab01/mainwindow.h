@@ -6,7 +6,11 @@
 #include <QTableWidgetItem>
 #include <QLineEdit>
 #include <QPainter>
+#include <QFutureWatcher>
+#include <QScopedPointer>
+#include <QTimer>
 #include "geometry.h"
+#include "search.h"
 
 namespace Ui {
 class MainWindow;
@@ -27,9 +31,13 @@ private slots:
 	void on_deletePointPushButton_clicked();
 	void on_calculatePushButton_clicked();
 	void on_clearPushButton_clicked();
+	void on_cancelPushButton_clicked();
 
 	void tableWidgetItem_changed(QTableWidgetItem *item);
 
+	void search_progress();
+	void search_finished();
+
 private:
 	bool get_var(double &var, const QLineEdit *lineEdit, const QString &err_msg);
 
@@ -38,6 +46,10 @@ private:
 	QPointF coord(const Point &point) const;
 	void drawLine(const Line &line, QPainter &painter);
 	QPen choosePen(int i) const;
+	void cancelSearch();
+	void applyRanking();
+	void invalidatePointsLayer();
+	void updateLayers();
 
 private:
 	Ui::MainWindow *ui;
@@ -49,7 +61,20 @@ private:
 	double x_max, y_max, x_min, y_min;
 	double scale_factor;
 
+	// offscreen layers, valid for layersViewport
+	QRectF layersViewport;
+	QPixmap axesLayer;
+	QPixmap pointsLayer;
+
+	TriangleRanking ranking;
+	QScopedPointer<TriangleSearch> search;
+	QFutureWatcher<SearchResult> searchWatcher;
+	// the running search was cancelled with the Cancel button, not by a point edit
+	bool cancelRequested;
+	QTimer progressTimer;
+
 	static const int STATUS_BAR_TIMEOUT = 10000;
+	static const int PROGRESS_INTERVAL = 100;
 	static const int PAINT_WIDTH = 1690;
 	static const int PAINT_HEIGHT = 991;
 };
@@ -0,0 +1,77 @@
+#include "pointset.h"
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define POINTSET_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <iterator>
+#endif
+
+bool read_points(std::istream& is, std::vector<Point>& points) {
+	double x, y;
+	while (is >> x) {
+		// a point cut short by the end of the stream is an error, not the end of the input
+		if (!(is >> y))
+			return false;
+		points.push_back(Point(x, y));
+	}
+	return is.eof();
+}
+
+static void append(const char *data, size_t size, std::vector<Point>& points) {
+	const size_t count = size / (2 * sizeof (double));
+	const size_t begin = points.size();
+	points.resize(begin + count);
+	for (size_t i = 0; i != count; ++i) {
+		std::memcpy(&points[begin + i].x, data + 2 * i * sizeof (double), sizeof (double));
+		std::memcpy(&points[begin + i].y, data + (2 * i + 1) * sizeof (double), sizeof (double));
+	}
+}
+
+ReadStatus read_points_binary(const char *path, std::vector<Point>& points) {
+#ifdef POINTSET_MMAP
+	const int fd = open(path, O_RDONLY);
+	if (fd == -1)
+		return READ_CANNOT_OPEN;
+
+	struct stat st;
+	if (fstat(fd, &st) == -1) {
+		close(fd);
+		return READ_CANNOT_OPEN;
+	}
+	if (st.st_size % (2 * sizeof (double))) {
+		close(fd);
+		return READ_INVALID;
+	}
+	if (!st.st_size) {
+		close(fd);
+		return READ_OK;
+	}
+
+	void *data = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED)
+		return READ_CANNOT_OPEN;
+
+	madvise(data, st.st_size, MADV_SEQUENTIAL);
+	append(static_cast<const char *>(data), st.st_size, points);
+	munmap(data, st.st_size);
+	return READ_OK;
+#else
+	std::ifstream file(path, std::ios::binary);
+	if (!file)
+		return READ_CANNOT_OPEN;
+
+	std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	if (data.size() % (2 * sizeof (double)))
+		return READ_INVALID;
+
+	append(data.data(), data.size(), points);
+	return READ_OK;
+#endif
+}
@@ -0,0 +1,23 @@
+#ifndef POINTSET_H_
+#define POINTSET_H_
+
+#include <istream>
+#include <vector>
+#include "geometry.h"
+
+// whitespace separated "x y" pairs until the end of the stream; false on anything else,
+// including a trailing x without its y
+bool read_points(std::istream& is, std::vector<Point>& points);
+
+enum ReadStatus {
+	READ_OK,
+	// the file could not be opened or mapped
+	READ_CANNOT_OPEN,
+	// the file was read but is not a whole number of points
+	READ_INVALID
+};
+
+// a file of native-endian double pairs x0 y0 x1 y1 ..., memory mapped where the platform allows
+ReadStatus read_points_binary(const char *path, std::vector<Point>& points);
+
+#endif // POINTSET_H_
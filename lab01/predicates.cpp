@@ -0,0 +1,123 @@
+#include "predicates.h"
+#include <cmath>
+
+// J. R. Shewchuk, Adaptive Precision Floating-Point Arithmetic and Fast Robust Geometric Predicates, 1997.
+// Expansions are arrays of nonoverlapping doubles in increasing order of magnitude whose exact sum is the value.
+
+static const double epsilon = std::ldexp(1.0, -53);
+static const double splitter = std::ldexp(1.0, 27) + 1.0;
+
+const double ORIENT2D_ERRBOUND = (3.0 + 16.0 * epsilon) * epsilon;
+
+// a + b = x + y exactly
+static inline void two_sum(double a, double b, double& x, double& y) {
+	x = a + b;
+	const double b_virtual = x - a;
+	const double a_virtual = x - b_virtual;
+	y = (a - a_virtual) + (b - b_virtual);
+}
+
+static inline void two_diff(double a, double b, double& x, double& y) {
+	x = a - b;
+	const double b_virtual = a - x;
+	const double a_virtual = x + b_virtual;
+	y = (a - a_virtual) + (b_virtual - b);
+}
+
+static inline void split(double a, double& hi, double& lo) {
+	const double c = splitter * a;
+	const double a_big = c - a;
+	hi = c - a_big;
+	lo = a - hi;
+}
+
+// a * b = x + y exactly
+static inline void two_product(double a, double b, double& x, double& y) {
+	x = a * b;
+	double a_hi, a_lo, b_hi, b_lo;
+	split(a, a_hi, a_lo);
+	split(b, b_hi, b_lo);
+	const double err1 = x - a_hi * b_hi;
+	const double err2 = err1 - a_lo * b_hi;
+	const double err3 = err2 - a_hi * b_lo;
+	y = a_lo * b_lo - err3;
+}
+
+// h = e * b, zero components eliminated; returns the length of h (at most 2 * elen)
+static int scale_expansion(int elen, const double *e, double b, double *h) {
+	int hlen = 0;
+	double q, hh, product1, product0, sum;
+	two_product(e[0], b, q, hh);
+	if (hh)
+		h[hlen++] = hh;
+	for (int i = 1; i < elen; ++i) {
+		two_product(e[i], b, product1, product0);
+		two_sum(q, product0, sum, hh);
+		if (hh)
+			h[hlen++] = hh;
+		two_sum(product1, sum, q, hh);
+		if (hh)
+			h[hlen++] = hh;
+	}
+	if (q || !hlen)
+		h[hlen++] = q;
+	return hlen;
+}
+
+// h = e + f, zero components eliminated; returns the length of h (at most elen + flen)
+static int expansion_sum(int elen, const double *e, int flen, const double *f, double *h) {
+	// merge by magnitude, then sweep with two_sum
+	double g[16] = {};
+	int i = 0, j = 0, glen = 0;
+	while (i < elen && j < flen)
+		g[glen++] = std::abs(e[i]) < std::abs(f[j]) ? e[i++] : f[j++];
+	while (i < elen)
+		g[glen++] = e[i++];
+	while (j < flen)
+		g[glen++] = f[j++];
+
+	int hlen = 0;
+	double q = g[0], hh;
+	for (int k = 1; k < glen; ++k) {
+		two_sum(q, g[k], q, hh);
+		if (hh)
+			h[hlen++] = hh;
+	}
+	if (q || !hlen)
+		h[hlen++] = q;
+	return hlen;
+}
+
+double orient2d_exact(const Point& A, const Point& B, const Point& C) {
+	double acx[2], bcy[2], acy[2], bcx[2];
+	two_diff(A.x, C.x, acx[1], acx[0]);
+	two_diff(B.y, C.y, bcy[1], bcy[0]);
+	two_diff(A.y, C.y, acy[1], acy[0]);
+	two_diff(B.x, C.x, bcx[1], bcx[0]);
+	for (int i = 0; i != 2; ++i)
+		acy[i] = -acy[i];
+
+	// det = acx * bcy + (-acy) * bcx, each product of two 2-component expansions
+	double t[4], u[4], left[8], right[8], det[16];
+	const int llen = expansion_sum(scale_expansion(2, acx, bcy[0], t), t, scale_expansion(2, acx, bcy[1], u), u, left);
+	const int rlen = expansion_sum(scale_expansion(2, acy, bcx[0], t), t, scale_expansion(2, acy, bcx[1], u), u, right);
+	const int dlen = expansion_sum(llen, left, rlen, right, det);
+
+	// components do not overlap, so the plain sum keeps the sign of the largest one
+	double sum = 0;
+	for (int i = 0; i != dlen; ++i)
+		sum += det[i];
+	return sum;
+}
+
+double orient2d(const Point& A, const Point& B, const Point& C) {
+	const double detleft = (A.x - C.x) * (B.y - C.y);
+	const double detright = (A.y - C.y) * (B.x - C.x);
+	const double det = detleft - detright;
+
+	const double errbound = ORIENT2D_ERRBOUND * (std::abs(detleft) + std::abs(detright));
+	if (det >= errbound || -det >= errbound)
+		return det;
+
+	return orient2d_exact(A, B, C);
+}
@@ -0,0 +1,17 @@
+#ifndef PREDICATES_H_
+#define PREDICATES_H_
+
+#include "geometry.h"
+
+// Shewchuk's adaptive orientation test: (A - C) x (B - C), i.e. twice the signed area of ABC,
+// positive for a counterclockwise triangle. The sign is always exact: a floating-point filter
+// settles the common case and exact expansion arithmetic takes over only when the filter's
+// error bound is exceeded. The magnitude is the exact value rounded.
+double orient2d(const Point& A, const Point& B, const Point& C);
+
+// error bound of the filter: |det| >= ORIENT2D_ERRBOUND * (|detleft| + |detright|) means the sign of det is right
+extern const double ORIENT2D_ERRBOUND;
+
+double orient2d_exact(const Point& A, const Point& B, const Point& C);
+
+#endif // PREDICATES_H_
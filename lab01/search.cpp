@@ -0,0 +1,326 @@
+#include "search.h"
+#include "batch.h"
+#include "dedup.h"
+#include <algorithm>
+#include <limits>
+#include <thread>
+
+double orthocenter_angle(const Point& orthocenter) {
+	static const Line y_axis(1, 0, 0);
+	return orthocenter == Point() ? 0.0 : angle(Line(orthocenter, Point()), y_axis);
+}
+
+SearchResult::SearchResult()
+	: i(-1)
+	, j(-1)
+	, k(-1)
+	, angle(-1)
+	{ }
+
+SearchResult::SearchResult(int i, int j, int k, double angle, const Point& orthocenter)
+	: i(i)
+	, j(j)
+	, k(k)
+	, angle(angle)
+	, orthocenter(orthocenter)
+	{ }
+
+bool SearchResult::found() const {
+	return k != -1;
+}
+
+bool better(const SearchResult& a, const SearchResult& b) {
+	if (a.angle != b.angle)
+		return a.angle > b.angle;
+	if (a.i != b.i)
+		return a.i < b.i;
+	if (a.j != b.j)
+		return a.j < b.j;
+	return a.k < b.k;
+}
+
+bool evaluate(const std::vector<Point>& points, int i, int j, int k, SearchResult& result) {
+	if (on_one_line(points[i], points[j], points[k]))
+		return false;
+
+	Point orthocenter = Triangle(points[i], points[j], points[k]).orthocenter();
+	result = SearchResult(i, j, k, orthocenter_angle(orthocenter), orthocenter);
+	return true;
+}
+
+TriangleRanking::TriangleRanking(size_t capacity /* = DEFAULT_CAPACITY */)
+	: capacity(std::max<size_t>(1, capacity))
+	, complete(false)
+	{ }
+
+void TriangleRanking::start() {
+	top.clear();
+	complete = true;
+}
+
+void TriangleRanking::clear() {
+	top.clear();
+	complete = false;
+}
+
+double TriangleRanking::key_threshold() const {
+	if (complete && top.size() < capacity)
+		return -std::numeric_limits<double>::infinity();
+	if (top.empty())
+		return std::numeric_limits<double>::infinity();
+	// the margin absorbs rounding between angle_key and the acos based angle
+	return angle_key(top.back().angle) - EPS;
+}
+
+void TriangleRanking::renumber(const std::vector<int>& origin) {
+	for (SearchResult& result : top) {
+		result.i = origin[result.i];
+		result.j = origin[result.j];
+		result.k = origin[result.k];
+	}
+}
+
+void TriangleRanking::keep_best() {
+	if (top.size() > 1)
+		top.resize(1);
+	if (!top.empty())
+		complete = false;
+}
+
+bool TriangleRanking::valid() const {
+	return complete || !top.empty();
+}
+
+SearchResult TriangleRanking::best() const {
+	return top.empty() ? SearchResult() : top.front();
+}
+
+void TriangleRanking::offer(const SearchResult& candidate) {
+	// unless everything is kept, a candidate below the worst kept one may rank below triangles already dropped
+	if (!complete && (top.empty() || !better(candidate, top.back())))
+		return;
+	if (top.size() == capacity && !better(candidate, top.back()))
+		return;
+
+	top.insert(std::upper_bound(top.begin(), top.end(), candidate, better), candidate);
+	if (top.size() > capacity) {
+		top.pop_back();
+		complete = false;
+	}
+}
+
+void TriangleRanking::merge(const TriangleRanking& other) {
+	std::vector<SearchResult> merged(top.size() + other.top.size());
+	std::merge(top.begin(), top.end(), other.top.begin(), other.top.end(), merged.begin(), better);
+
+	complete = complete && other.complete && merged.size() <= capacity;
+	if (merged.size() > capacity)
+		merged.resize(capacity);
+	top.swap(merged);
+}
+
+void TriangleRanking::drop(int index) {
+	top.erase(std::remove_if(top.begin(), top.end(), [index](const SearchResult& result) {
+		return result.i == index || result.j == index || result.k == index;
+	}), top.end());
+}
+
+void TriangleRanking::offer_all_with(const std::vector<Point>& points, int index) {
+	const int n = points.size();
+	SearchResult current;
+	for (int a = 0; a < n - 1; ++a)
+		for (int b = a + 1; b < n; ++b) {
+			if (a == index || b == index)
+				continue;
+
+			int i = a, j = b, k = index;
+			if (k < j)
+				std::swap(j, k);
+			if (j < i)
+				std::swap(i, j);
+			if (evaluate(points, i, j, k, current))
+				offer(current);
+		}
+}
+
+void TriangleRanking::point_added(const std::vector<Point>& points) {
+	if (!valid())
+		return;
+
+	offer_all_with(points, points.size() - 1);
+}
+
+void TriangleRanking::point_removed(int index) {
+	if (!valid())
+		return;
+
+	drop(index);
+	// the remaining indices shift down by one, which keeps their order and so the ranking
+	for (SearchResult& result : top) {
+		result.i -= result.i > index;
+		result.j -= result.j > index;
+		result.k -= result.k > index;
+	}
+}
+
+void TriangleRanking::point_changed(const std::vector<Point>& points, int index) {
+	if (!valid())
+		return;
+
+	drop(index);
+	if (valid())
+		offer_all_with(points, index);
+}
+
+TriangleSearch::TriangleSearch(const std::vector<Point>& input)
+	: input_size(input.size())
+	, next_block(0)
+	, triangles_done(0)
+	, stop(false)
+	, triangles_total(0) {
+	// an exact duplicate only repeats triangles of the point it equals or makes degenerate ones
+	deduplicate(input, points, origin);
+
+	const long long n = points.size();
+	if (n >= 3 && !all_collinear(points))
+		triangles_total = n * (n - 1) * (n - 2) / 6;
+
+	xs.resize(points.size());
+	ys.resize(points.size());
+	for (size_t i = 0; i != points.size(); ++i) {
+		xs[i] = points[i].x;
+		ys[i] = points[i].y;
+	}
+}
+
+void TriangleSearch::split(unsigned blocks_per_thread, unsigned threads) {
+	blocks.clear();
+
+	const int n = points.size();
+	if (!triangles_total)
+		return;
+
+	// pair (i, j) stands for n - 1 - j triangles, so blocks are cut by triangle count, not by pair count
+	const long long target = std::max(1LL, triangles_total / (static_cast<long long>(blocks_per_thread) * threads));
+
+	Block block = { 0, 1, 0 };
+	long long weight = 0;
+	for (int i = 0; i < n - 2; ++i)
+		for (int j = i + 1; j < n - 1; ++j) {
+			if (!block.pairs)
+				block.i = i, block.j = j;
+			++block.pairs;
+			weight += n - 1 - j;
+			if (weight >= target) {
+				blocks.push_back(block);
+				block.pairs = 0;
+				weight = 0;
+			}
+		}
+	if (block.pairs)
+		blocks.push_back(block);
+}
+
+SearchResult TriangleSearch::run(unsigned threads /* = 0 */, size_t capacity /* = 1 */) {
+	if (!threads)
+		threads = std::max(1u, std::thread::hardware_concurrency());
+
+	split(16, threads);
+	next_block = 0;
+	triangles_done = 0;
+
+	std::vector<TriangleRanking> best(threads, TriangleRanking(capacity));
+	for (TriangleRanking& ranking : best)
+		ranking.start();
+	std::vector<std::thread> workers;
+	for (unsigned t = 1; t < threads; ++t)
+		workers.emplace_back(&TriangleSearch::work, this, std::ref(best[t]));
+	work(best[0]);
+	for (std::thread& worker : workers)
+		worker.join();
+
+	// every candidate is ranked by `better`, a total order, so the outcome does not depend on scheduling
+	result = TriangleRanking(capacity);
+	result.start();
+	for (const TriangleRanking& ranking : best)
+		result.merge(ranking);
+	result.renumber(origin);
+	// triangles through the collapsed duplicates tie with ranked ones without being ranked,
+	// so past the best one the ranking would not be exact
+	if (points.size() != input_size)
+		result.keep_best();
+	if (stop)
+		result.clear();
+	return result.best();
+}
+
+const TriangleRanking& TriangleSearch::ranking() const {
+	return result;
+}
+
+void TriangleSearch::work(TriangleRanking& best) {
+	Batch batch;
+	batch.hx.resize(points.size());
+	batch.hy.resize(points.size());
+	batch.key.resize(points.size());
+	batch.collinear.resize(points.size());
+
+	for (;;) {
+		const size_t b = next_block++;
+		if (b >= blocks.size() || stop)
+			return;
+		search_block(blocks[b], batch, best);
+	}
+}
+
+// The batch kernel does the heavy part for all k at once; only triangles that may get into
+// the ranking have their angle computed, by the same orthocenter_angle as everywhere else.
+void TriangleSearch::search_block(const Block& block, Batch& batch, TriangleRanking& best) {
+	const int n = points.size();
+	int i = block.i;
+	int j = block.j;
+	for (long long p = 0; p != block.pairs && !stop; ++p) {
+		orthocenter_batch(
+			points[i], points[j],
+			&xs[j + 1], &ys[j + 1], n - 1 - j,
+			&batch.hx[0], &batch.hy[0], &batch.key[0], &batch.collinear[0]
+		);
+
+		double threshold = best.key_threshold();
+		for (int k = j + 1; k < n; ++k) {
+			const int b = k - j - 1;
+			if (batch.collinear[b] || batch.key[b] < threshold)
+				continue;
+
+			const Point orthocenter(batch.hx[b], batch.hy[b]);
+			best.offer(SearchResult(i, j, k, orthocenter_angle(orthocenter), orthocenter));
+			threshold = best.key_threshold();
+		}
+		triangles_done.fetch_add(n - 1 - j, std::memory_order_relaxed);
+
+		if (++j == n - 1) {
+			++i;
+			j = i + 1;
+		}
+	}
+}
+
+void TriangleSearch::cancel() {
+	stop = true;
+}
+
+bool TriangleSearch::cancelled() const {
+	return stop;
+}
+
+long long TriangleSearch::done() const {
+	return triangles_done.load(std::memory_order_relaxed);
+}
+
+long long TriangleSearch::total() const {
+	return triangles_total;
+}
+
+size_t TriangleSearch::distinct() const {
+	return points.size();
+}
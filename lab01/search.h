@@ -0,0 +1,116 @@
+#ifndef SEARCH_H_
+#define SEARCH_H_
+
+#include <atomic>
+#include <vector>
+#include "geometry.h"
+
+// angle between the line (orthocenter, origin) and the y axis
+double orthocenter_angle(const Point& orthocenter);
+
+struct SearchResult {
+	int i, j, k;
+	double angle;
+	Point orthocenter;
+
+	SearchResult();
+	SearchResult(int i, int j, int k, double angle, const Point& orthocenter);
+
+	bool found() const;
+};
+
+// Greater angle wins; equal angles are resolved in favour of the lexicographically
+// smaller (i, j, k), i.e. the triangle the serial i < j < k loop meets first.
+bool better(const SearchResult& a, const SearchResult& b);
+
+// false for collinear i, j, k
+bool evaluate(const std::vector<Point>& points, int i, int j, int k, SearchResult& result);
+
+// The best `capacity` triangles of a point set, best first.
+// Every triangle left out ranks below all of the kept ones, so after a point is deleted the
+// survivors still hold the maximum; only when none survive a full search is required.
+class TriangleRanking {
+public:
+	static const size_t DEFAULT_CAPACITY = 64;
+
+	// an invalid ranking: nothing is known until the first full search
+	explicit TriangleRanking(size_t capacity = DEFAULT_CAPACITY);
+
+	void offer(const SearchResult& candidate);
+	void merge(const TriangleRanking& other);
+
+	// O(n^2) updates, `points` is the point set after the change
+	void point_added(const std::vector<Point>& points);
+	void point_removed(int index);
+	void point_changed(const std::vector<Point>& points, int index);
+
+	void start();
+	void clear();
+	// index -> origin[index]; origin must be increasing, which keeps the order
+	void renumber(const std::vector<int>& origin);
+	// forget all but the best one
+	void keep_best();
+
+	bool valid() const;
+	SearchResult best() const;
+	// a candidate with a smaller angle_key would be turned down by offer
+	double key_threshold() const;
+
+private:
+	void drop(int index);
+	void offer_all_with(const std::vector<Point>& points, int index);
+
+	size_t capacity;
+	std::vector<SearchResult> top;
+	// top holds every triangle there is, so any new one may be ranked
+	bool complete;
+};
+
+class TriangleSearch {
+public:
+	// Exact duplicates are collapsed first (see deduplicate); results are in input indices.
+	explicit TriangleSearch(const std::vector<Point>& input);
+
+	// threads == 0 means one thread per core
+	SearchResult run(unsigned threads = 0, size_t capacity = 1);
+	const TriangleRanking& ranking() const;
+
+	void cancel();
+	bool cancelled() const;
+
+	long long done() const;
+	long long total() const;
+	size_t distinct() const;
+
+private:
+	// a run of consecutive (i, j) pairs starting at (i, j), covering `pairs` pairs
+	struct Block {
+		int i, j;
+		long long pairs;
+	};
+
+	void split(unsigned blocks_per_thread, unsigned threads);
+
+	// per-thread output of orthocenter_batch
+	struct Batch {
+		std::vector<double> hx, hy, key;
+		std::vector<unsigned char> collinear;
+	};
+
+	void work(TriangleRanking& best);
+	void search_block(const Block& block, Batch& batch, TriangleRanking& best);
+
+	size_t input_size;
+	std::vector<Point> points;
+	std::vector<int> origin;
+	std::vector<double> xs, ys;
+	std::vector<Block> blocks;
+	TriangleRanking result;
+
+	std::atomic<size_t> next_block;
+	std::atomic<long long> triangles_done;
+	std::atomic<bool> stop;
+	long long triangles_total;
+};
+
+#endif // SEARCH_H_
@@ -0,0 +1,42 @@
+#!/bin/sh
+# Checks the exit codes of lab01-cli: 0 found, 1 invalid input, 3 no triangle,
+# 4 the file can not be opened.
+# Usage: cli.sh path/to/lab01-cli
+
+CLI=${1:?usage: $0 path/to/lab01-cli}
+failed=0
+
+expect() {
+	code=$1
+	input=$2
+	printf '%s' "$input" | "$CLI" > /dev/null 2>&1
+	actual=$?
+	if [ "$actual" != "$code" ]; then
+		echo "FAIL: input \"$input\": exit code $actual, expected $code"
+		failed=1
+	fi
+}
+
+expect 0 "0 0 1 0 0 1"
+expect 0 "0 0 1 0 0 1
+"
+expect 3 "0 0 1 0"
+expect 3 ""
+# trailing x without its y
+expect 1 "0 0 1"
+expect 1 "0 0 1 0 0 1 2"
+expect 1 "0 0 x"
+
+# a missing file is not invalid input
+missing=${TMPDIR:-/tmp}/lab01-cli-missing-$$
+for args in "$missing" "--binary $missing"; do
+	"$CLI" $args > /dev/null 2>&1
+	actual=$?
+	if [ "$actual" != 4 ]; then
+		echo "FAIL: $args: exit code $actual, expected 4"
+		failed=1
+	fi
+done
+
+[ $failed = 0 ] && echo "All CLI tests passed"
+exit $failed
@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "dedup.h"
+#include "search.h"
+
+static int failures = 0;
+
+#define CHECK(condition) do { \
+	if (!(condition)) { \
+		std::cerr << __FILE__ << ':' << __LINE__ << ": FAIL: " #condition "\n"; \
+		++failures; \
+	} \
+} while (0)
+
+// the serial i < j < k loop over all input points, duplicates included
+static SearchResult brute_force(const std::vector<Point>& points) {
+	SearchResult best;
+	const int n = points.size();
+	for (int i = 0; i < n; ++i)
+		for (int j = i + 1; j < n; ++j)
+			for (int k = j + 1; k < n; ++k) {
+				SearchResult candidate;
+				if (evaluate(points, i, j, k, candidate) && (!best.found() || better(candidate, best)))
+					best = candidate;
+			}
+	return best;
+}
+
+static bool same(const SearchResult& a, const SearchResult& b) {
+	return a.found() == b.found() && (!a.found() || (a.i == b.i && a.j == b.j && a.k == b.k && a.angle == b.angle));
+}
+
+static void test_near_duplicates_are_kept() {
+	const std::vector<Point> points = { Point(0, 0), Point(EPS / 2, 0), Point(1, 1) };
+	std::vector<Point> unique;
+	std::vector<int> origin;
+	deduplicate(points, unique, origin);
+	CHECK(unique.size() == 3);
+}
+
+static void test_exact_duplicates_are_merged() {
+	const std::vector<Point> points = { Point(1, 2), Point(0.0, 0.0), Point(1, 2), Point(-0.0, 0.0) };
+	std::vector<Point> unique;
+	std::vector<int> origin;
+	deduplicate(points, unique, origin);
+	CHECK(unique.size() == 2);
+	CHECK(origin == std::vector<int>({ 0, 1 }));
+}
+
+// points EPS * 0.6 apart: each is within EPS of its neighbours but not of both ends, and no
+// order of the input merges any of them
+static void test_chain_does_not_depend_on_order() {
+	std::vector<Point> points = { Point(0, 0), Point(0.6 * EPS, 0), Point(1.2 * EPS, 0) };
+	for (int rotation = 0; rotation != 3; ++rotation) {
+		std::vector<Point> unique;
+		std::vector<int> origin;
+		deduplicate(points, unique, origin);
+		CHECK(unique.size() == 3);
+		std::rotate(points.begin(), points.begin() + 1, points.end());
+	}
+}
+
+static std::vector<Point> random_points(std::mt19937& random, int n) {
+	std::uniform_real_distribution<double> coordinate(-10, 10);
+	std::vector<Point> points;
+	for (int i = 0; i != n; ++i)
+		points.push_back(Point(coordinate(random), coordinate(random)));
+	return points;
+}
+
+// a pair EPS / 2 apart forms real triangles, and the search must rank them like any other
+static void test_search_with_near_duplicates() {
+	std::mt19937 random(34);
+	for (int round = 0; round != 50; ++round) {
+		std::vector<Point> points = random_points(random, 12);
+		points.push_back(Point(points[round % 12].x + EPS / 2, points[round % 12].y));
+
+		TriangleSearch search(points);
+		CHECK(search.distinct() == points.size());
+		CHECK(same(search.run(2), brute_force(points)));
+	}
+}
+
+// a triangle through an exact duplicate is the triangle through the point it repeats, with the
+// vertices in another order, so its angle may differ from the reported one in the last bits only
+static void test_search_with_exact_duplicates() {
+	std::mt19937 random(34);
+	for (int round = 0; round != 50; ++round) {
+		std::vector<Point> points = random_points(random, 12);
+		points.push_back(points[round % 12]);
+
+		TriangleSearch search(points);
+		CHECK(search.distinct() == points.size() - 1);
+		const SearchResult found = search.run(2);
+		const SearchResult expected = brute_force(points);
+		CHECK(found.found() && std::abs(found.angle - expected.angle) < 1e-12);
+
+		std::vector<Point> a = { points[found.i], points[found.j], points[found.k] };
+		std::vector<Point> b = { points[expected.i], points[expected.j], points[expected.k] };
+		const auto less = [](const Point& p, const Point& q) { return p.x < q.x || (p.x == q.x && p.y < q.y); };
+		std::sort(a.begin(), a.end(), less);
+		std::sort(b.begin(), b.end(), less);
+		CHECK(a[0].x == b[0].x && a[0].y == b[0].y && a[1].x == b[1].x && a[1].y == b[1].y
+		      && a[2].x == b[2].x && a[2].y == b[2].y);
+	}
+}
+
+int main()
+{
+	test_near_duplicates_are_kept();
+	test_exact_duplicates_are_merged();
+	test_chain_does_not_depend_on_order();
+	test_search_with_near_duplicates();
+	test_search_with_exact_duplicates();
+
+	if (failures) {
+		std::cerr << failures << " checks failed\n";
+		return EXIT_FAILURE;
+	}
+	std::cout << "All tests passed\n";
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,27 @@
+#-------------------------------------------------
+#
+# lab01 search and dedup checks: no Qt, no MainWindow
+#
+#-------------------------------------------------
+
+TARGET = lab01-tests
+TEMPLATE = app
+CONFIG += console c++11 thread
+CONFIG -= app_bundle qt
+
+INCLUDEPATH += ..
+
+SOURCES += \
+        tests.cpp \
+        ../geometry.cpp \
+        ../search.cpp \
+        ../batch.cpp \
+        ../predicates.cpp \
+        ../dedup.cpp
+
+HEADERS += \
+        ../geometry.h \
+        ../search.h \
+        ../batch.h \
+        ../predicates.h \
+        ../dedup.h
@@ -0,0 +1,20 @@
+#-------------------------------------------------
+#
+# Transform::applyBatch throughput, 10M points by default
+#
+#-------------------------------------------------
+
+TARGET = lab02-bench
+TEMPLATE = app
+CONFIG += console c++14 thread release
+CONFIG -= app_bundle qt
+
+INCLUDEPATH += ..
+
+SOURCES += \
+        main.cpp \
+        ../transform.cpp
+
+HEADERS += \
+        ../transform.h \
+        ../point.h
@@ -0,0 +1,66 @@
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "transform.h"
+
+typedef std::chrono::steady_clock Clock;
+
+template <typename F>
+static double best(int trials, F f) {
+	double result = 1e100;
+	for (int trial = 0; trial != trials; ++trial) {
+		const Clock::time_point start = Clock::now();
+		f();
+		result = std::min(result, std::chrono::duration<double>(Clock::now() - start).count());
+	}
+	return result;
+}
+
+static void report(const char* name, double seconds, std::size_t n) {
+	std::cout << name << ": " << seconds * 1e3 << " ms, " << n / seconds / 1e6 << " Mpoints/s\n";
+}
+
+int main(int argc, char* argv[])
+{
+	const std::size_t n = argc > 1 ? std::strtoul(argv[1], 0, 10) : 10000000;
+	const int trials = 5;
+
+	std::vector<double> x(n), y(n), outX(n), outY(n);
+	std::mt19937 gen(1);
+	std::uniform_real_distribution<double> coord(-10, 10);
+	for (std::size_t i = 0; i != n; ++i) {
+		x[i] = coord(gen);
+		y[i] = coord(gen);
+	}
+
+	Transform transform;
+	transform.translate(Point(3, -2));
+	transform.scale(Point(1.5, 0.5), Point(1, 1));
+	transform.rotate(M_PI / 7, Point(-1, 2));
+
+	report("apply", best(trials, [&]() {
+		for (std::size_t i = 0; i != n; ++i) {
+			const Point p = transform.apply(Point(x[i], y[i]));
+			outX[i] = p.x;
+			outY[i] = p.y;
+		}
+	}), n);
+	report("applyBatch, 1 thread", best(trials, [&]() {
+		transform.applyBatch(&x[0], &y[0], &outX[0], &outY[0], n, 1);
+	}), n);
+	report("applyBatch, all threads", best(trials, [&]() {
+		transform.applyBatch(&x[0], &y[0], &outX[0], &outY[0], n);
+	}), n);
+
+	for (std::size_t i = 0; i != n; ++i) {
+		const Point p = transform.apply(Point(x[i], y[i]));
+		if (std::abs(p.x - outX[i]) > 1e-12 * (1 + std::abs(p.x)) || std::abs(p.y - outY[i]) > 1e-12 * (1 + std::abs(p.y))) {
+			std::cout << "Mismatch at " << i << '\n';
+			return 1;
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,88 @@
+#include "framestats.h"
+
+#include <algorithm>
+#include <cmath>
+
+const char* const FrameStats::STAGE_NAMES[FrameStats::STAGES] = {
+	"compose",
+	"tessellate",
+	"fill",
+	"blit"
+};
+
+double FrameStats::Frame::total() const {
+	double sum = 0;
+	for (int i = 0; i != STAGES; ++i)
+		sum += stage[i];
+	return sum;
+}
+
+FrameStats::FrameStats(std::size_t capacity)
+	: capacity(std::max<std::size_t>(1, capacity))
+	, next(0) {
+	frames.reserve(this->capacity);
+}
+
+void FrameStats::add(const Frame& frame) {
+	if (frames.size() < capacity) {
+		frames.push_back(frame);
+		return;
+	}
+	frames[next] = frame;
+	next = (next + 1) % capacity;
+}
+
+void FrameStats::clear() {
+	frames.clear();
+	next = 0;
+}
+
+bool FrameStats::empty() const {
+	return frames.empty();
+}
+
+std::size_t FrameStats::size() const {
+	return frames.size();
+}
+
+const FrameStats::Frame& FrameStats::operator[](std::size_t i) const {
+	return frames[(next + i) % frames.size()];
+}
+
+// nearest-rank percentiles
+FrameStats::Summary FrameStats::summary(int stage) const {
+	Summary result = { 0, 0, 0 };
+	if (frames.empty())
+		return result;
+
+	std::vector<double> values;
+	values.reserve(frames.size());
+	for (const Frame& frame : frames)
+		values.push_back(stage == STAGES ? frame.total() : frame.stage[stage]);
+
+	const std::size_t n = values.size();
+	const std::size_t median = (n - 1) / 2;
+	const std::size_t p99 = static_cast<std::size_t>(std::ceil(0.99 * n)) - 1;
+
+	result.min = *std::min_element(values.begin(), values.end());
+	std::nth_element(values.begin(), values.begin() + median, values.end());
+	result.median = values[median];
+	std::nth_element(values.begin(), values.begin() + p99, values.end());
+	result.p99 = values[p99];
+	return result;
+}
+
+void FrameStats::writeCsv(QTextStream& out) const {
+	out << "frame";
+	for (int i = 0; i != STAGES; ++i)
+		out << ',' << STAGE_NAMES[i] << "_ms";
+	out << ",total_ms\n";
+
+	for (std::size_t f = 0; f != size(); ++f) {
+		const Frame& frame = (*this)[f];
+		out << f;
+		for (int i = 0; i != STAGES; ++i)
+			out << ',' << frame.stage[i];
+		out << ',' << frame.total() << '\n';
+	}
+}
@@ -0,0 +1,56 @@
+#ifndef FRAMESTATS_H
+#define FRAMESTATS_H
+
+#include <QTextStream>
+#include <cstddef>
+#include <vector>
+
+// Per-stage durations of the last `capacity` frames, oldest first once the ring wraps.
+class FrameStats {
+public:
+	enum Stage {
+		COMPOSE,
+		TESSELLATE,
+		FILL,
+		BLIT,
+		STAGES
+	};
+
+	static const char* const STAGE_NAMES[STAGES];
+
+	// milliseconds
+	struct Frame {
+		double stage[STAGES];
+
+		double total() const;
+	};
+
+	struct Summary {
+		double min;
+		double median;
+		double p99;
+	};
+
+	explicit FrameStats(std::size_t capacity = 600);
+
+	void add(const Frame& frame);
+	void clear();
+
+	bool empty() const;
+	std::size_t size() const;
+	const Frame& operator[](std::size_t i) const;
+
+	// stage == STAGES summarizes the frame totals
+	Summary summary(int stage) const;
+
+	// one header line and then a line per frame, oldest first
+	void writeCsv(QTextStream& out) const;
+
+private:
+	std::vector<Frame> frames;
+	std::size_t capacity;
+	// where the next frame goes once the ring is full
+	std::size_t next;
+};
+
+#endif // FRAMESTATS_H
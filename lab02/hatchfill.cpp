@@ -0,0 +1,166 @@
+#include "hatchfill.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+// An edge in the hatch frame, where hatch lines are v = const and run along u; v0 < v1.
+struct Edge {
+	double u0, v0;
+	double v1;
+	double slope;
+	int winding;
+	bool outer;
+};
+
+struct Crossing {
+	double u;
+	int winding;
+	bool outer;
+
+	bool operator<(const Crossing &other) const { return u < other.u; }
+};
+
+}
+
+static void addEdges(std::vector<Edge> &edges, const QVector<QPointF> &contour, const QPointF &along, const QPointF &across, bool outer)
+{
+	const int n = contour.size();
+	for (int i = 0; i != n; ++i) {
+		const QPointF &p = contour[i];
+		const QPointF &q = contour[(i + 1) % n];
+		double u0 = p.x() * along.x() + p.y() * along.y();
+		double v0 = p.x() * across.x() + p.y() * across.y();
+		double u1 = q.x() * along.x() + q.y() * along.y();
+		double v1 = q.x() * across.x() + q.y() * across.y();
+		if (v0 == v1)
+			continue;
+
+		int winding = 1;
+		if (v0 > v1) {
+			std::swap(u0, u1);
+			std::swap(v0, v1);
+			winding = -1;
+		}
+		edges.push_back({ u0, v0, v1, (u1 - u0) / (v1 - v0), winding, outer });
+	}
+}
+
+// plots the segment a-b one pixel per step of the longer axis
+static void plotSpan(QRgb *bits, int stride, int width, int height, const QPointF &a, const QPointF &b, QRgb color)
+{
+	const double dx = b.x() - a.x();
+	const double dy = b.y() - a.y();
+	const int steps = std::ceil(std::max(std::abs(dx), std::abs(dy)));
+	const double sx = steps ? dx / steps : 0;
+	const double sy = steps ? dy / steps : 0;
+
+	double x = a.x();
+	double y = a.y();
+	for (int i = 0; i <= steps; ++i, x += sx, y += sy) {
+		const int px = std::floor(x);
+		const int py = std::floor(y);
+		if (0 <= px && px < width && 0 <= py && py < height)
+			bits[py * stride + px] = color;
+	}
+}
+
+// Narrows [u0, u1] on the hatch line v to the part inside the image; false if nothing is left.
+static bool clipSpan(double &u0, double &u1, double v, const QPointF &along, const QPointF &across, int width, int height)
+{
+	// p(u) = u * along + v * across, with 0 <= p.x <= width and 0 <= p.y <= height
+	const double origin[2] = { v * across.x(), v * across.y() };
+	const double direction[2] = { along.x(), along.y() };
+	const double size[2] = { double(width), double(height) };
+	for (int axis = 0; axis != 2; ++axis) {
+		if (direction[axis] == 0) {
+			if (origin[axis] < 0 || origin[axis] > size[axis])
+				return false;
+			continue;
+		}
+		double t0 = -origin[axis] / direction[axis];
+		double t1 = (size[axis] - origin[axis]) / direction[axis];
+		if (t0 > t1)
+			std::swap(t0, t1);
+		u0 = std::max(u0, t0);
+		u1 = std::min(u1, t1);
+	}
+	return u0 < u1;
+}
+
+void hatchFill(QImage &image, const QVector<QPointF> &outer, const QVector<QPointF> &hole, const HatchStyle &style)
+{
+	// screen y grows downwards, so a counter-clockwise angle turns towards -y
+	const QPointF along(std::cos(style.angle), -std::sin(style.angle));
+	const QPointF across(std::sin(style.angle), std::cos(style.angle));
+
+	std::vector<Edge> edges;
+	edges.reserve(outer.size() + hole.size());
+	addEdges(edges, outer, along, across, true);
+	addEdges(edges, hole, along, across, false);
+	if (edges.empty())
+		return;
+
+	std::sort(edges.begin(), edges.end(), [](const Edge &a, const Edge &b) {
+		return a.v0 < b.v0;
+	});
+
+	double vMax = edges[0].v1;
+	for (const Edge &edge : edges)
+		vMax = std::max(vMax, edge.v1);
+
+	QRgb *bits = reinterpret_cast<QRgb *>(image.bits());
+	const int stride = image.bytesPerLine() / sizeof(QRgb);
+	const int width = image.width();
+	const int height = image.height();
+
+	// lines off the image are skipped, edges still enter the active list in order
+	const double corners[4] = { 0, width * across.x(), height * across.y(), width * across.x() + height * across.y() };
+	const double vFirst = std::max(edges[0].v0, *std::min_element(corners, corners + 4));
+	vMax = std::min(vMax, *std::max_element(corners, corners + 4));
+
+	std::vector<const Edge *> active;
+	std::vector<Crossing> crossings;
+	size_t next = 0;
+	// lines sit at v = k * spacing
+	for (double line = std::ceil(vFirst / style.spacing); line * style.spacing < vMax; ++line) {
+		const double v = line * style.spacing;
+
+		// edges cover [v0, v1), so a vertex shared by two edges is crossed once
+		while (next != edges.size() && edges[next].v0 <= v)
+			active.push_back(&edges[next++]);
+		active.erase(std::remove_if(active.begin(), active.end(), [v](const Edge *edge) {
+			return edge->v1 <= v;
+		}), active.end());
+
+		crossings.clear();
+		for (const Edge *edge : active)
+			crossings.push_back({ edge->u0 + (v - edge->v0) * edge->slope, edge->winding, edge->outer });
+		std::sort(crossings.begin(), crossings.end());
+
+		bool parity = false;
+		int winding = 0;
+		for (size_t i = 0; i + 1 < crossings.size(); ++i) {
+			if (crossings[i].outer)
+				parity = !parity;
+			else
+				winding += crossings[i].winding;
+
+			if (!parity || winding || crossings[i].u == crossings[i + 1].u)
+				continue;
+
+			double u0 = crossings[i].u;
+			double u1 = crossings[i + 1].u;
+			if (!clipSpan(u0, u1, v, along, across, width, height))
+				continue;
+			plotSpan(
+				bits, stride, width, height,
+				QPointF(u0 * along.x() + v * across.x(), u0 * along.y() + v * across.y()),
+				QPointF(u1 * along.x() + v * across.x(), u1 * along.y() + v * across.y()),
+				style.color
+			);
+		}
+	}
+}
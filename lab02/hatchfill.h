@@ -0,0 +1,22 @@
+#ifndef HATCHFILL_H
+#define HATCHFILL_H
+
+#include <QImage>
+#include <QVector>
+#include <QPointF>
+
+struct HatchStyle {
+	// of the hatch lines, counter-clockwise from the x axis as seen on screen
+	double angle;
+	// between neighbouring lines, in pixels
+	double spacing;
+	QRgb color;
+};
+
+// Hatches the region inside `outer` (even-odd rule) and outside `hole` (non-zero winding rule)
+// straight into `image` (Format_ARGB32 or Format_ARGB32_Premultiplied). Contours are closed
+// polygons in pixel coordinates. Hatch lines are anchored to the image, not to the contours,
+// like Qt brush patterns are.
+void hatchFill(QImage &image, const QVector<QPointF> &outer, const QVector<QPointF> &hole, const HatchStyle &style);
+
+#endif // HATCHFILL_H
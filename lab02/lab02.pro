@@ -10,6 +10,7 @@ greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
 TARGET = lab02
 TEMPLATE = app
+CONFIG += c++14
 
 # The following define makes your compiler emit warnings if you use
 # any feature of Qt which has been marked as deprecated (the exact warnings
@@ -26,13 +27,20 @@ DEFINES += QT_DEPRECATED_WARNINGS
 SOURCES += \
         main.cpp \
         mainwindow.cpp \
+    framestats.cpp \
+    hatchfill.cpp \
+    tessellation.cpp \
     transform.cpp \
-    point.cpp
+    transformhistory.cpp
 
 HEADERS += \
         mainwindow.h \
+    framestats.h \
+    hatchfill.h \
+    tessellation.h \
     transform.h \
-    point.h
+    point.h \
+    transformhistory.h
 
 FORMS += \
         mainwindow.ui
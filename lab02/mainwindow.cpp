@@ -1,6 +1,9 @@
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
 
+#include <QFile>
+#include <QFileDialog>
+#include <QTextStream>
 #include <QVector>
 #include <cmath>
 
@@ -11,6 +14,8 @@ MainWindow::MainWindow(QWidget *parent)
 	ui->setupUi(this);
 
 	initPoints();
+
+	connect(&animationTimer, &QTimer::timeout, this, &MainWindow::animationTick);
 }
 
 MainWindow::~MainWindow()
@@ -33,12 +38,7 @@ void MainWindow::on_translatePushButton_clicked()
 	   && get_var(y, ui->yLineEdit, "Invalid y")))
 		return;
 
-	Transform translation;
-	translation.translate(Point(x, y));
-	transforms.push_back(translation);
-
-	ui->statusBar->showMessage("Translated successful", STATUS_BAR_TIMEOUT);
-	update();
+	play({ TRANSLATION, "Translated successful", Point(), Point(x, y), Point(1, 1), 0 });
 }
 
 void MainWindow::on_scalePushButton_clicked()
@@ -50,12 +50,7 @@ void MainWindow::on_scalePushButton_clicked()
 	   && get_var(ky, ui->kyLineEdit, "Invalid ky")))
 		return;
 
-	Transform scaling;
-	scaling.scale(Point(kx, ky), Point(x, y));
-	transforms.push_back(scaling);
-
-	ui->statusBar->showMessage("Scaled successful", STATUS_BAR_TIMEOUT);
-	update();
+	play({ SCALING, "Scaled successful", Point(x, y), Point(), Point(kx, ky), 0 });
 }
 
 void MainWindow::on_rotatePushButton_clicked()
@@ -66,22 +61,18 @@ void MainWindow::on_rotatePushButton_clicked()
 	   && get_var(alpha, ui->alphaLineEdit, "Invalid alpha")))
 		return;
 
-	Transform rotation;
-	rotation.rotate(alpha * M_PIl / 180, Point(x, y));
-	transforms.push_back(rotation);
-
-	ui->statusBar->showMessage("Rotated successful", STATUS_BAR_TIMEOUT);
-	update();
+	play({ ROTATION, "Rotated successful", Point(x, y), Point(), Point(1, 1), alpha * M_PIl / 180 });
 }
 
 void MainWindow::on_undoPushButton_clicked()
 {
+	finishAnimation();
 	if (transforms.empty()) {
 		ui->statusBar->showMessage("There are no transforms");
 		return;
 	}
 
-	transforms.pop_back();
+	transforms.undo();
 
 	ui->statusBar->showMessage("Undo successful", STATUS_BAR_TIMEOUT);
 	update();
@@ -89,28 +80,138 @@ void MainWindow::on_undoPushButton_clicked()
 
 void MainWindow::on_clearPushButton_clicked()
 {
+	finishAnimation();
 	transforms.clear();
 	update();
 }
 
+void MainWindow::play(const Animation &next)
+{
+	finishAnimation();
+
+	if (!ui->animationCheckBox->isChecked()) {
+		transforms.push(animationStep(next, 1));
+		ui->statusBar->showMessage(next.message, STATUS_BAR_TIMEOUT);
+		update();
+		return;
+	}
+
+	animation = next;
+	animationClock.start();
+	animationTimer.start(FRAME_INTERVAL);
+}
+
+// jumps to the end of the running animation, if any
+void MainWindow::finishAnimation()
+{
+	if (animation.kind == NO_ANIMATION)
+		return;
+
+	animationTimer.stop();
+	transforms.push(animationStep(animation, 1));
+	ui->statusBar->showMessage(animation.message, STATUS_BAR_TIMEOUT);
+	animation.kind = NO_ANIMATION;
+
+	showFrameStats();
+	update();
+}
+
+void MainWindow::animationTick()
+{
+	if (animationProgress() >= 1) {
+		finishAnimation();
+		return;
+	}
+
+	showFrameStats();
+	update();
+}
+
+double MainWindow::animationProgress() const
+{
+	if (animation.kind == NO_ANIMATION)
+		return 0;
+	return qMin(1.0, animationClock.elapsed() / double(ANIMATION_DURATION));
+}
+
+Transform MainWindow::animationStep(const Animation &animation, double t)
+{
+	Transform step;
+	switch (animation.kind) {
+	case TRANSLATION:
+		step.translate(Point(t * animation.offset.x, t * animation.offset.y));
+		break;
+	case SCALING:
+		step.scale(Point(1 + t * (animation.factor.x - 1), 1 + t * (animation.factor.y - 1)), animation.center);
+		break;
+	case ROTATION:
+		step.rotate(t * animation.angle, animation.center);
+		break;
+	case NO_ANIMATION:
+		break;
+	}
+	return step;
+}
+
+void MainWindow::showFrameStats()
+{
+	QString text = QString("%1 frames, ms\n%2 %3 %4 %5\n")
+		.arg(int(frameStats.size()))
+		.arg("", -10).arg("min", 6).arg("median", 6).arg("p99", 6);
+
+	for (int stage = 0; stage <= FrameStats::STAGES; ++stage) {
+		const FrameStats::Summary summary = frameStats.summary(stage);
+		text += QString("%1 %2 %3 %4\n")
+			.arg(stage == FrameStats::STAGES ? "total" : FrameStats::STAGE_NAMES[stage], -10)
+			.arg(summary.min, 6, 'f', 2)
+			.arg(summary.median, 6, 'f', 2)
+			.arg(summary.p99, 6, 'f', 2);
+	}
+
+	ui->statsLabel->setText(text);
+}
+
 void MainWindow::initPoints()
 {
-	points = QVector<Point>(n + 4);
+	points = QVector<Point>(4);
 
 	points[0] = Point(8, 0);
 	points[1] = Point(0, 3);
 	points[2] = Point(-8, 0);
 	points[3] = Point(0, -3);
 
-	for (int i = 0; i < n; ++i) {
-		double t = 2 * M_PIl * i / n;
+	limaconPoints.clear();
+}
+
+// Resamples the limaçon only when the view has stretched or shrunk it enough
+// to leave the pixel tolerance or to waste vertices; moves and turns never do,
+// unless the off-screen part was left coarse and may come into view.
+void MainWindow::updateLimacon(const Transform &view)
+{
+	if (!limaconPoints.empty() && (!limaconCulled || view == limaconView)) {
+		const double grow = stretch(limaconView, view);
+		if (TESSELLATION_STRETCH_MIN <= grow && grow <= TESSELLATION_STRETCH_MAX)
+			return;
+	}
+
+	const double a = this->a;
+	const double b = this->b;
+	const ParametricCurve limacon = [a, b](double t) {
 		double cost = std::cos(t);
 		double sint = std::sin(t);
-		points[i + 4] = Point(
+		return Point(
 			a * cost * cost + b * cost - a + b,
 			a * cost * sint + b * sint
 		);
-	}
+	};
+
+	// the view maps onto the paint area with the origin at its centre
+	const Point half(PAINT_WIDTH / 2.0, PAINT_HEIGHT / 2.0);
+	limaconPoints = tessellate(
+		limacon, 0, 2 * M_PI, view, TESSELLATION_TOLERANCE,
+		Point(-half.x, -half.y), half, &limaconCulled
+	);
+	limaconView = view;
 }
 
 double MainWindow::x_coord(double x) const
@@ -141,14 +242,22 @@ QPen MainWindow::choosePen(int i) const
 
 void MainWindow::paintEvent(QPaintEvent *)
 {
+	QElapsedTimer clock;
+	clock.start();
+	// milliseconds since the previous lap
+	const auto lap = [&clock]() {
+		const double elapsed = clock.nsecsElapsed() / 1e6;
+		clock.restart();
+		return elapsed;
+	};
+	FrameStats::Frame frame;
+
 	QPainter painter(this);
 	painter.translate(230, 0);
 
-	painter.fillRect(0, 0, PAINT_WIDTH, PAINT_HEIGHT, QBrush(Qt::white));
-
-	Transform transform;
-	for (int i = transforms.size() - 1; i >= 0; --i)
-		transform.combine(transforms[i]);
+	Transform transform = transforms.composed();
+	if (animation.kind != NO_ANIMATION)
+		transform = animationStep(animation, animationProgress()).combined(transform);
 
 	compress = 1;
 
@@ -179,16 +288,33 @@ void MainWindow::paintEvent(QPaintEvent *)
 		}
 	}
 
+	frame.stage[FrameStats::COMPOSE] = lap();
+
 	QVector<QPointF> rhomb(4);
 	for (int i = 0; i != 4; ++i) {
 		rhomb[i] = coord(_rhomb[i]);
 	}
 
-	QVector<QPointF> limacon(n);
-	for (int i = 0; i != n; ++i) {
-		limacon[i] = coord(transform.apply(points[i + 4]));
+	const double scale = NORMAL_SCALE_FACTOR / compress;
+	updateLimacon(Transform::scaling(Point(scale, scale)).combined(transform));
+
+	QVector<QPointF> limacon(limaconPoints.size());
+	for (int i = 0; i != limacon.size(); ++i) {
+		limacon[i] = coord(transform.apply(limaconPoints[i]));
 	}
 
+	frame.stage[FrameStats::TESSELLATE] = lap();
+
+	// the hatch of Qt::BDiagPattern: 45 degrees, 8 pixels apart along a row
+	if (hatchLayer.size() != QSize(PAINT_WIDTH, PAINT_HEIGHT))
+		hatchLayer = QImage(PAINT_WIDTH, PAINT_HEIGHT, QImage::Format_ARGB32_Premultiplied);
+	hatchLayer.fill(Qt::transparent);
+	hatchFill(hatchLayer, rhomb, limacon, { M_PI / 4, 8 / M_SQRT2, qRgb(0, 0, 0) });
+
+	frame.stage[FrameStats::FILL] = lap();
+
+	painter.fillRect(0, 0, PAINT_WIDTH, PAINT_HEIGHT, QBrush(Qt::white));
+
 	int m = PAINT_HEIGHT * compress / (2 * NORMAL_SCALE_FACTOR);
 	for (int i = -m; i != m + 1; ++i) {
 		painter.setPen(choosePen(i));
@@ -200,24 +326,46 @@ void MainWindow::paintEvent(QPaintEvent *)
 		painter.drawLine(QPointF(x_coord(i), 0), QPointF(x_coord(i), PAINT_HEIGHT));
 	}
 
-	QPainterPath rhombPath;
-	rhombPath.addPolygon(QPolygonF(rhomb));
-	painter.setPen(QPen(Qt::black, 2));
-	painter.setBrush(Qt::BDiagPattern);
-
-	QPainterPath limaconPath;
-	limaconPath.setFillRule(Qt::WindingFill);
-	limaconPath.addPolygon(QPolygonF(limacon));
+	painter.drawImage(0, 0, hatchLayer);
 
-	QPainterPath figurePath = rhombPath.subtracted(limaconPath);
-	painter.drawPath(figurePath);
-
-	painter.setBrush(Qt::NoBrush);
-	painter.drawPath(limaconPath);
+	painter.setPen(QPen(Qt::black, 2));
+	painter.drawPolygon(QPolygonF(rhomb));
+	painter.drawPolygon(QPolygonF(limacon));
 	painter.drawPoint(rhomb[0]);
+
+	frame.stage[FrameStats::BLIT] = lap();
+	frameStats.add(frame);
 }
 
 void MainWindow::on_autoscalingCheckBox_stateChanged(int arg1)
 {
 	autoscaling = arg1;
 }
+
+void MainWindow::on_dumpStatsPushButton_clicked()
+{
+	if (frameStats.empty()) {
+		ui->statusBar->showMessage("There are no frames", STATUS_BAR_TIMEOUT);
+		return;
+	}
+
+	const QString path = QFileDialog::getSaveFileName(this, "Save frame times", "frames.csv", "CSV (*.csv)");
+	if (path.isEmpty())
+		return;
+
+	QFile file(path);
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+		ui->statusBar->showMessage("Could not write " + path, STATUS_BAR_TIMEOUT);
+		return;
+	}
+	{
+		QTextStream out(&file);
+		frameStats.writeCsv(out);
+	}
+	file.close();
+
+	if (file.error() != QFileDevice::NoError)
+		ui->statusBar->showMessage("Could not write " + path, STATUS_BAR_TIMEOUT);
+	else
+		ui->statusBar->showMessage("Saved " + path, STATUS_BAR_TIMEOUT);
+}
@@ -4,7 +4,12 @@
 #include <QMainWindow>
 #include <QLineEdit>
 #include <QPainter>
-#include "transform.h"
+#include <QElapsedTimer>
+#include <QTimer>
+#include "framestats.h"
+#include "hatchfill.h"
+#include "tessellation.h"
+#include "transformhistory.h"
 
 namespace Ui {
 class MainWindow;
@@ -30,9 +35,13 @@ private slots:
 	bool get_var(double &var, const QLineEdit *lineEdit, const QString &err_msg);
 
 	void on_autoscalingCheckBox_stateChanged(int arg1);
+	void on_dumpStatsPushButton_clicked();
+
+	void animationTick();
 
 private:
 	void initPoints();
+	void updateLimacon(const Transform &view);
 	double x_coord(double x) const;
 	double y_coord(double y) const;
 	QPointF coord(const Point &point) const;
@@ -56,9 +65,49 @@ private:
 	double kx, ky;
 	double alpha;
 
-	int n = 1000;
+	// limaçon error in pixels, and how much the view may stretch it before it is resampled
+	static constexpr double TESSELLATION_TOLERANCE = 0.4;
+	static constexpr double TESSELLATION_STRETCH_MAX = 1.25;
+	static constexpr double TESSELLATION_STRETCH_MIN = 0.5;
+
+	// a transform being played instead of applied at once, see animationStep
+	enum AnimationKind {
+		NO_ANIMATION,
+		TRANSLATION,
+		SCALING,
+		ROTATION
+	};
+
+	struct Animation {
+		AnimationKind kind;
+		QString message;
+		Point center;
+		Point offset;
+		Point factor;
+		double angle;
+	};
+
+	static const int ANIMATION_DURATION = 1000;
+	static const int FRAME_INTERVAL = 16;
+
+	void play(const Animation &next);
+	void finishAnimation();
+	double animationProgress() const;
+	// the part of the animated transform done by t in [0, 1]
+	static Transform animationStep(const Animation &animation, double t);
+	void showFrameStats();
+
+	Animation animation = { NO_ANIMATION, QString(), Point(), Point(), Point(), 0 };
+	QTimer animationTimer;
+	QElapsedTimer animationClock;
+	FrameStats frameStats;
+
 	QVector<Point> points;
-	QVector<Transform> transforms;
+	std::vector<Point> limaconPoints;
+	Transform limaconView;
+	bool limaconCulled = false;
+	QImage hatchLayer;
+	TransformHistory transforms;
 
 };
 
@@ -1,6 +0,0 @@
-#include "point.h"
-
-Point::Point(double x, double y)
-	: x(x)
-	, y(y)
-{ }
@@ -4,7 +4,14 @@
 struct Point {
 	double x, y;
 
-	Point(double x = 0, double y = 0);
+	constexpr Point(double x = 0, double y = 0)
+		: x(x)
+		, y(y)
+	{ }
 };
 
+constexpr bool operator==(const Point& a, const Point& b) {
+	return a.x == b.x && a.y == b.y;
+}
+
 #endif // POINT_H
@@ -0,0 +1,105 @@
+#include "tessellation.h"
+
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+// enough initial segments not to step over the inner loop of a limaçon
+static const int INITIAL_SEGMENTS = 16;
+static const int MAX_DEPTH = 16;
+
+static double distanceToSegment(const Point& p, const Point& a, const Point& b) {
+	const double dx = b.x - a.x;
+	const double dy = b.y - a.y;
+	const double length2 = dx * dx + dy * dy;
+	double t = length2 ? ((p.x - a.x) * dx + (p.y - a.y) * dy) / length2 : 0;
+	t = t < 0 ? 0 : t > 1 ? 1 : t;
+	return std::hypot(p.x - a.x - t * dx, p.y - a.y - t * dy);
+}
+
+struct Viewport {
+	Point min, max;
+	bool culled;
+};
+
+// Whether the curve through a, m, b (in view space) may cross the viewport. The bounding box of
+// the three points is grown by its own size, which generously covers how far a segment that bends less than
+// a half turn can bulge out of it.
+static bool mayBeVisible(const Point& a, const Point& m, const Point& b, const Viewport& viewport) {
+	const double minX = std::min({ a.x, m.x, b.x });
+	const double maxX = std::max({ a.x, m.x, b.x });
+	const double minY = std::min({ a.y, m.y, b.y });
+	const double maxY = std::max({ a.y, m.y, b.y });
+	const double margin = std::max(maxX - minX, maxY - minY);
+	return minX - margin <= viewport.max.x && viewport.min.x <= maxX + margin
+		&& minY - margin <= viewport.max.y && viewport.min.y <= maxY + margin;
+}
+
+// appends the samples of (ta, tb]
+static void subdivide(
+	const ParametricCurve& curve, const Transform& view, double tolerance, Viewport& viewport,
+	double ta, const Point& a, double tb, const Point& b, int depth,
+	std::vector<Point>& result
+) {
+	const double tm = 0.5 * (ta + tb);
+	const Point m = curve(tm);
+	const Point va = view.apply(a);
+	const Point vm = view.apply(m);
+	const Point vb = view.apply(b);
+	if (depth < MAX_DEPTH && distanceToSegment(vm, va, vb) > tolerance) {
+		if (!mayBeVisible(va, vm, vb, viewport)) {
+			viewport.culled = true;
+			result.push_back(b);
+			return;
+		}
+		subdivide(curve, view, tolerance, viewport, ta, a, tm, m, depth + 1, result);
+		subdivide(curve, view, tolerance, viewport, tm, m, tb, b, depth + 1, result);
+	}
+	else
+		result.push_back(b);
+}
+
+std::vector<Point> tessellate(
+	const ParametricCurve& curve, double t0, double t1, const Transform& view, double tolerance,
+	const Point& viewMin, const Point& viewMax, bool* culled
+) {
+	std::vector<Point> result;
+	Viewport viewport = { viewMin, viewMax, false };
+
+	double ta = t0;
+	Point a = curve(t0);
+	result.push_back(a);
+	for (int i = 1; i <= INITIAL_SEGMENTS; ++i) {
+		const double tb = t0 + (t1 - t0) * i / INITIAL_SEGMENTS;
+		const Point b = curve(tb);
+		subdivide(curve, view, tolerance, viewport, ta, a, tb, b, 0, result);
+		ta = tb;
+		a = b;
+	}
+
+	// the curve is closed, curve(t1) repeats curve(t0)
+	result.pop_back();
+	if (culled)
+		*culled = viewport.culled;
+	return result;
+}
+
+double stretch(const Transform& previous, const Transform& next) {
+	if (!previous.determinant()) {
+		// nothing to compare against, but a view that stays singular keeps its samples
+		// rather than being resampled every frame
+		const bool same =
+			previous.applyVector(Point(1, 0)) == next.applyVector(Point(1, 0))
+			&& previous.applyVector(Point(0, 1)) == next.applyVector(Point(0, 1));
+		return same ? 1 : std::numeric_limits<double>::infinity();
+	}
+
+	const Transform relative = next.combined(previous.inverted());
+	const Point c1 = relative.applyVector(Point(1, 0));
+	const Point c2 = relative.applyVector(Point(0, 1));
+
+	// largest singular value of the 2x2 matrix [c1 c2]
+	const double e = 0.5 * (c1.x * c1.x + c1.y * c1.y + c2.x * c2.x + c2.y * c2.y);
+	const double det = c1.x * c2.y - c2.x * c1.y;
+	return std::sqrt(e + std::sqrt(std::max(0.0, e * e - det * det)));
+}
@@ -0,0 +1,29 @@
+#ifndef TESSELLATION_H
+#define TESSELLATION_H
+
+#include <functional>
+#include <vector>
+#include "transform.h"
+
+typedef std::function<Point(double)> ParametricCurve;
+
+// Samples the closed curve t -> curve(t), t in [t0, t1), with as few vertices as it takes for
+// the polyline to stay within `tolerance` of the curve once mapped by `view` (model to pixels).
+// Segments are split at the parameter midpoint while the curve's midpoint is farther than
+// `tolerance` from the chord, so flat stretches get few vertices and tight bends many.
+// Segments that stay clear of the view-space rectangle [viewMin, viewMax] are not split at all:
+// zoomed far in, nearly all of the curve is off-screen and would otherwise get most of the
+// vertices. `culled`, if given, is set when that happened; such a tessellation is only
+// good for the same view.
+std::vector<Point> tessellate(
+	const ParametricCurve& curve, double t0, double t1, const Transform& view, double tolerance,
+	const Point& viewMin, const Point& viewMax, bool* culled = nullptr
+);
+
+// How much longer `next` can make a vector than `previous` did: the largest singular value of
+// the linear part of next * previous^-1. A tessellation made for `previous` deviates by at most
+// tolerance * stretch(previous, next) under `next`. A singular `previous` flattens the curve and
+// bounds nothing: the result is 1 if `next` has the same linear part, infinity otherwise.
+double stretch(const Transform& previous, const Transform& next);
+
+#endif // TESSELLATION_H
@@ -1,82 +1,97 @@
 #include "transform.h"
 
-#include <cstring>
 #include <cmath>
+#include <thread>
+#include <vector>
+#include <algorithm>
 
-const Transform Transform::identity = {
-	1, 0, 0,
-	0, 1, 0,
-	0, 0, 1
-};
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TRANSFORM_AVX2
+#include <immintrin.h>
+#endif
 
-Transform::Transform() {
-	*this = identity;
-}
-
-Transform::Transform(const Transform& other) {
-	std::memcpy(matrix, other.matrix, 9 * sizeof (double));
-}
+// below this many points a batch is not worth starting threads for
+static const std::size_t THREAD_THRESHOLD = 1 << 18;
 
-Transform::Transform(
-	double m00, double m01, double m02,
-	double m10, double m11, double m12,
-	double m20, double m21, double m22
-) {
-	matrix[0] = m00; matrix[1] = m01; matrix[2] = m02;
-	matrix[3] = m10; matrix[4] = m11; matrix[5] = m12;
-	matrix[6] = m20; matrix[7] = m21; matrix[8] = m22;
-}
+const Transform Transform::identity;
 
 void Transform::translate(const Point& offset) {
-	Transform translation = {
-		1, 0, offset.x,
-		0, 1, offset.y,
-		0, 0, 1
-	};
-	combine(translation);
+	combine(translation(offset));
 }
 
 void Transform::scale(const Point &factor, const Point &center) {
-	Transform scaling = {
-		factor.x, 0,        center.x * (1 - factor.x),
-		0,        factor.y, center.y * (1 - factor.y),
-		0,        0,        1
-	};
-	combine(scaling);
+	combine(scaling(factor, center));
 }
 
 void Transform::rotate(double angle, const Point &center) {
-	double cos_a = std::cos(angle);
-	double sin_a = std::sin(angle);
-	Transform rotation = {
-		cos_a, -sin_a, center.x * (1 - cos_a) + center.y * sin_a,
-		sin_a, cos_a,  center.y * (1 - cos_a) - center.x * sin_a,
-		0,     0,      1
-	};
-	combine(rotation);
+	combine(rotation(std::cos(angle), std::sin(angle), center));
 }
 
 void Transform::combine(const Transform &other) {
-	const double* a = matrix;
-	const double* b = other.matrix;
-
-	*this = Transform(
-		a[0] * b[0] + a[1] * b[3] + a[2] * b[6],
-		a[0] * b[1] + a[1] * b[4] + a[2] * b[7],
-		a[0] * b[2] + a[1] * b[5] + a[2] * b[8],
-		a[3] * b[0] + a[4] * b[3] + a[5] * b[6],
-		a[3] * b[1] + a[4] * b[4] + a[5] * b[7],
-		a[3] * b[2] + a[4] * b[5] + a[5] * b[8],
-		a[6] * b[0] + a[7] * b[3] + a[8] * b[6],
-		a[6] * b[1] + a[7] * b[4] + a[8] * b[7],
-		a[6] * b[2] + a[7] * b[5] + a[8] * b[8]
-	);
+	*this = combined(other);
 }
 
-Point Transform::apply(const Point& point) const {
-	return Point(
-		matrix[0] * point.x + matrix[1] * point.y + matrix[2],
-		matrix[3] * point.x + matrix[4] * point.y + matrix[5]
-	);
+#ifdef TRANSFORM_AVX2
+
+__attribute__((target("avx2,fma")))
+static std::size_t applyAvx2(const double* m, const double* x, const double* y, double* outX, double* outY, std::size_t count) {
+	const __m256d m0 = _mm256_set1_pd(m[0]);
+	const __m256d m1 = _mm256_set1_pd(m[1]);
+	const __m256d m2 = _mm256_set1_pd(m[2]);
+	const __m256d m3 = _mm256_set1_pd(m[3]);
+	const __m256d m4 = _mm256_set1_pd(m[4]);
+	const __m256d m5 = _mm256_set1_pd(m[5]);
+
+	std::size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		const __m256d vx = _mm256_loadu_pd(x + i);
+		const __m256d vy = _mm256_loadu_pd(y + i);
+		_mm256_storeu_pd(outX + i, _mm256_fmadd_pd(m0, vx, _mm256_fmadd_pd(m1, vy, m2)));
+		_mm256_storeu_pd(outY + i, _mm256_fmadd_pd(m3, vx, _mm256_fmadd_pd(m4, vy, m5)));
+	}
+	return i;
 }
 
+static bool hasAvx2Fma() {
+	static const bool supported = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+	return supported;
+}
+
+#endif // TRANSFORM_AVX2
+
+void Transform::applyRange(const double* x, const double* y, double* outX, double* outY, std::size_t count) const {
+	std::size_t i = 0;
+#ifdef TRANSFORM_AVX2
+	if (hasAvx2Fma())
+		i = applyAvx2(matrix, x, y, outX, outY, count);
+#endif
+	for (; i != count; ++i) {
+		const double px = x[i];
+		const double py = y[i];
+		outX[i] = matrix[0] * px + matrix[1] * py + matrix[2];
+		outY[i] = matrix[3] * px + matrix[4] * py + matrix[5];
+	}
+}
+
+void Transform::applyBatch(
+	const double* x, const double* y,
+	double* outX, double* outY,
+	std::size_t count, unsigned threads
+) const {
+	if (!threads)
+		threads = std::max(1u, std::thread::hardware_concurrency());
+	if (count < THREAD_THRESHOLD || threads == 1) {
+		applyRange(x, y, outX, outY, count);
+		return;
+	}
+
+	// chunks are multiples of 4 so that only the last one has a scalar tail
+	const std::size_t chunk = (count / threads + 3) & ~static_cast<std::size_t>(3);
+	std::vector<std::thread> workers;
+	std::size_t begin = 0;
+	for (unsigned t = 1; t < threads && begin + chunk < count; ++t, begin += chunk)
+		workers.emplace_back(&Transform::applyRange, this, x + begin, y + begin, outX + begin, outY + begin, chunk);
+	applyRange(x + begin, y + begin, outX + begin, outY + begin, count - begin);
+	for (std::thread& worker : workers)
+		worker.join();
+}
@@ -1,30 +1,164 @@
 #ifndef TRANSFORM_H
 #define TRANSFORM_H
 
+#include <cstddef>
 #include "point.h"
 
+// Affine transform. The bottom row of the 3x3 matrix is always 0 0 1 and is not stored,
+// so combining takes 12 multiplications and applying 4 multiply-adds per point.
+// The static factories are constexpr: a fixed pipeline such as
+//     constexpr Transform t = Transform::rotation(M_PI / 4).combined(Transform::translation(Point(1, 2)));
+// is folded at compile time.
 class Transform {
 public:
 	static const Transform identity;
 
 private:
-	double matrix[9];
+	// | matrix[0] matrix[1] matrix[2] |
+	// | matrix[3] matrix[4] matrix[5] |
+	double matrix[6];
 
 public:
-	Transform();
-	Transform(const Transform& other);
-	Transform(
+	constexpr Transform()
+		: matrix{ 1, 0, 0, 0, 1, 0 }
+	{ }
+
+	constexpr Transform(
 		double m00, double m01, double m02,
-		double m10, double m11, double m12,
-		double m20, double m21, double m22
-	);
+		double m10, double m11, double m12
+	)
+		: matrix{ m00, m01, m02, m10, m11, m12 }
+	{ }
+
+	static constexpr Transform translation(const Point& offset) {
+		return Transform(
+			1, 0, offset.x,
+			0, 1, offset.y
+		);
+	}
+
+	static constexpr Transform scaling(const Point& factor, const Point& center = Point()) {
+		return Transform(
+			factor.x, 0,        center.x * (1 - factor.x),
+			0,        factor.y, center.y * (1 - factor.y)
+		);
+	}
+
+	static constexpr Transform rotation(double cos_a, double sin_a, const Point& center) {
+		return Transform(
+			cos_a, -sin_a, center.x * (1 - cos_a) + center.y * sin_a,
+			sin_a, cos_a,  center.y * (1 - cos_a) - center.x * sin_a
+		);
+	}
+
+	static constexpr Transform rotation(double angle, const Point& center = Point()) {
+		return rotation(cosine(angle), sine(angle), center);
+	}
+
+	// this after other: combined(other).apply(p) == apply(other.apply(p))
+	constexpr Transform combined(const Transform& other) const {
+		const double* a = matrix;
+		const double* b = other.matrix;
+		return Transform(
+			a[0] * b[0] + a[1] * b[3],
+			a[0] * b[1] + a[1] * b[4],
+			a[0] * b[2] + a[1] * b[5] + a[2],
+			a[3] * b[0] + a[4] * b[3],
+			a[3] * b[1] + a[4] * b[4],
+			a[3] * b[2] + a[4] * b[5] + a[5]
+		);
+	}
 
 	void translate(const Point& offset);
 	void scale(const Point& factor, const Point& center = Point());
 	void rotate(double angle, const Point& center = Point());
 	void combine(const Transform& other);
 
-	Point apply(const Point& point) const;
+	constexpr Point apply(const Point& point) const {
+		return Point(
+			matrix[0] * point.x + matrix[1] * point.y + matrix[2],
+			matrix[3] * point.x + matrix[4] * point.y + matrix[5]
+		);
+	}
+
+	// the linear part only, for difference vectors
+	constexpr Point applyVector(const Point& vector) const {
+		return Point(
+			matrix[0] * vector.x + matrix[1] * vector.y,
+			matrix[3] * vector.x + matrix[4] * vector.y
+		);
+	}
+
+	constexpr double determinant() const {
+		return matrix[0] * matrix[4] - matrix[1] * matrix[3];
+	}
+
+	constexpr bool operator==(const Transform& other) const {
+		for (int i = 0; i != 6; ++i)
+			if (matrix[i] != other.matrix[i])
+				return false;
+		return true;
+	}
+
+	// requires determinant() != 0
+	constexpr Transform inverted() const {
+		const double det = determinant();
+		return Transform(
+			matrix[4] / det, -matrix[1] / det, (matrix[1] * matrix[5] - matrix[4] * matrix[2]) / det,
+			-matrix[3] / det, matrix[0] / det, (matrix[3] * matrix[2] - matrix[0] * matrix[5]) / det
+		);
+	}
+
+	// apply() for `count` points given as coordinate arrays, outX/outY may be x/y.
+	// Vectorized with AVX2 and FMA when available and split across threads for large inputs
+	// (threads == 0: one per core); with FMA the results may differ from apply() in the last bit.
+	void applyBatch(
+		const double* x, const double* y,
+		double* outX, double* outY,
+		std::size_t count, unsigned threads = 0
+	) const;
+
+private:
+	void applyRange(const double* x, const double* y, double* outX, double* outY, std::size_t count) const;
+
+	// Taylor series after reduction to [-pi, pi], for compile-time rotations;
+	// at run time rotate() uses std::cos and std::sin
+	static constexpr double PI = 3.14159265358979323846;
+
+	// 2 pi in three parts (Cody and Waite). The first two have 31 and 32 significant bits, so
+	// k * TWO_PI_HI is exact for |k| < 2^22 and k * TWO_PI_MID for |k| < 2^21. For
+	// |angle| < 2^21 * 2 pi, about 1.3e7, the reduced angle is as accurate as the one std::cos
+	// and std::sin reduce to, instead of losing bits as the angle grows.
+	static constexpr double TWO_PI_HI = 6.2831853069365025;
+	static constexpr double TWO_PI_MID = 2.4308402025215864e-10;
+	static constexpr double TWO_PI_LO = 8.089064995183803e-21;
+
+	static constexpr double reduce(double angle) {
+		const double k = static_cast<double>(static_cast<long long>(angle / (2 * PI) + (angle < 0 ? -0.5 : 0.5)));
+		return ((angle - k * TWO_PI_HI) - k * TWO_PI_MID) - k * TWO_PI_LO;
+	}
+
+	static constexpr double sine(double angle) {
+		const double x = reduce(angle);
+		double term = x;
+		double sum = x;
+		for (int n = 1; n != 24; ++n) {
+			term *= -x * x / ((2 * n) * (2 * n + 1));
+			sum += term;
+		}
+		return sum;
+	}
+
+	static constexpr double cosine(double angle) {
+		const double x = reduce(angle);
+		double term = 1;
+		double sum = 1;
+		for (int n = 1; n != 24; ++n) {
+			term *= -x * x / ((2 * n - 1) * (2 * n));
+			sum += term;
+		}
+		return sum;
+	}
 };
 
 #endif // TRANSFORM_H
@@ -0,0 +1,29 @@
+#include "transformhistory.h"
+
+void TransformHistory::push(const Transform& transform) {
+	Transform prefix(transform);
+	if (!prefixes.empty())
+		prefix.combine(prefixes.back());
+	prefixes.push_back(prefix);
+}
+
+void TransformHistory::undo() {
+	if (!prefixes.empty())
+		prefixes.pop_back();
+}
+
+void TransformHistory::clear() {
+	prefixes.clear();
+}
+
+bool TransformHistory::empty() const {
+	return prefixes.empty();
+}
+
+std::size_t TransformHistory::size() const {
+	return prefixes.size();
+}
+
+const Transform& TransformHistory::composed() const {
+	return prefixes.empty() ? Transform::identity : prefixes.back();
+}
@@ -0,0 +1,25 @@
+#ifndef TRANSFORMHISTORY_H
+#define TRANSFORMHISTORY_H
+
+#include <vector>
+#include "transform.h"
+
+// Stack of transforms that stores the composition of every prefix instead of the transforms
+// themselves, so push, undo and getting the composed transform are all O(1).
+class TransformHistory {
+private:
+	std::vector<Transform> prefixes;
+
+public:
+	void push(const Transform& transform);
+	void undo();
+	void clear();
+
+	bool empty() const;
+	std::size_t size() const;
+
+	// the last pushed transform applied after all the previous ones
+	const Transform& composed() const;
+};
+
+#endif // TRANSFORMHISTORY_H
@@ -0,0 +1,19 @@
+#include "algorithms.h"
+
+const QVector<Algorithm> &lineAlgorithms()
+{
+	static const QVector<Algorithm> algorithms = {
+		{ "DDA", QColor(0, 0, 0xff), dda, dda, dda },
+		{ "DDA (fixed point)", QColor(0, 0x80, 0xff), ddaFixed, ddaFixed, ddaFixed },
+		{ "DDA (AVX2)", QColor(0x80, 0, 0xff), ddaSimd, ddaSimd, ddaSimd },
+		{ "Bresenham (float)", QColor(0, 0xff, 0), bresenhamFloat, bresenhamFloat, bresenhamFloat },
+		{ "Bresenham (integer)", QColor(0xff, 0, 0xff), bresenhamInteger, bresenhamInteger, bresenhamInteger },
+		{ "Bresenham (run-slice)", QColor(0, 0xa0, 0xa0), bresenhamRunSlice, bresenhamRunSlice, bresenhamRunSlice },
+		{ "Bresenham (pattern cache)", QColor(0xa0, 0x50, 0), bresenhamPattern, bresenhamPattern, bresenhamPattern },
+		{ "Bresenham (double-step)", QColor(0x50, 0xa0, 0x50), bresenhamDoubleStep, bresenhamDoubleStep, bresenhamDoubleStep },
+		{ "Bresenham (anti-aliased)", QColor(0xff, 0, 0), bresenhamAntialiased, bresenhamAntialiased, bresenhamAntialiased },
+		{ "Wu", Qt::gray, wu, wu, wu },
+		{ "Wu (integer)", QColor(0x80, 0x80, 0), wuInteger, wuInteger, wuInteger }
+	};
+	return algorithms;
+}
@@ -0,0 +1,22 @@
+#ifndef ALGORITHMS_H
+#define ALGORITHMS_H
+
+#include <QColor>
+#include <QVector>
+
+#include "line.h"
+
+// Алгоритм построения отрезков с выводом в изображение (draw), только с вычислениями (compute) и
+// с записью пикселов по порядку (record)
+struct Algorithm {
+	const char *name;
+	QColor color;
+	bool (*draw)(const QLine &, Canvas &);
+	bool (*compute)(const QLine &, ChecksumSink &);
+	bool (*record)(const QLine &, RecordSink &);
+};
+
+// Все алгоритмы из line.h, кроме стандартного алгоритма Qt: он рисует только через QPainter
+const QVector<Algorithm> &lineAlgorithms();
+
+#endif // ALGORITHMS_H
@@ -0,0 +1,287 @@
+#include "benchmark.h"
+#include "algorithms.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStandardPaths>
+#include <QSysInfo>
+#include <QThread>
+
+#include <algorithm>
+#include <cmath>
+
+static const int CENTER = 360;
+static const int SIZE = 2 * CENTER + 1;
+
+// Процентиль по ближайшему рангу
+static double percentile(const QVector<double> &sorted, double p)
+{
+	const int rank = int(std::ceil(p * sorted.size()));
+	return sorted[qBound(0, rank - 1, sorted.size() - 1)];
+}
+
+// Отрезки длины length из центра под каждым из углов
+static QVector<QLine> spokes(int length, const QVector<int> &angles)
+{
+	QVector<QLine> lines;
+	for (int angle : angles) {
+		const double radians = angle * M_PI / 180;
+		lines.append(QLine(CENTER, CENTER,
+		                   CENTER + qRound(length * std::cos(radians)),
+		                   CENTER - qRound(length * std::sin(radians))));
+	}
+	return lines;
+}
+
+template <typename Target>
+static void measure(bool (*f)(const QLine &, Target &), Target &target,
+             const Benchmark::Config &config, const QVector<QVector<QLine>> &lines,
+             Benchmark::Series &series)
+{
+	QVector<double> trials(config.trials);
+	for (const QVector<QLine> &group : lines) {
+		for (int trial = -config.warmup; trial != config.trials; ++trial) {
+			QElapsedTimer timer;
+			timer.start();
+			for (int k = 0; k != config.repeats; ++k)
+				for (const QLine &line : group)
+					f(line, target);
+			if (trial >= 0)
+				trials[trial] = double(timer.nsecsElapsed()) / (config.repeats * group.size());
+		}
+
+		std::sort(trials.begin(), trials.end());
+		series.median.append(percentile(trials, 0.5));
+		series.p10.append(percentile(trials, 0.1));
+		series.p90.append(percentile(trials, 0.9));
+	}
+}
+
+static QJsonArray toArray(const QVector<double> &values)
+{
+	QJsonArray array;
+	for (double value : values)
+		array.append(value);
+	return array;
+}
+
+static QVector<double> fromArray(const QJsonValue &value)
+{
+	QVector<double> values;
+	for (const QJsonValue &item : value.toArray())
+		values.append(item.toDouble());
+	return values;
+}
+
+Benchmark::Config::Config()
+	: minLength(1)
+	, maxLength(100)
+	, lengthStep(1)
+	, angles({ 45 })
+	, repeats(100)
+	, trials(11)
+	, warmup(2)
+{ }
+
+QVector<int> Benchmark::Config::lengths() const
+{
+	QVector<int> result;
+	for (int length = minLength; length <= maxLength; length += qMax(1, lengthStep))
+		result.append(length);
+	return result;
+}
+
+QString Benchmark::Config::key() const
+{
+	QStringList degrees;
+	for (int angle : angles)
+		degrees.append(QString::number(angle));
+	return QString("lengths %1..%2 step %3, angles %4, repeats %5, trials %6, warmup %7")
+	        .arg(minLength).arg(maxLength).arg(lengthStep).arg(degrees.join(' '))
+	        .arg(repeats).arg(trials).arg(warmup);
+}
+
+Benchmark::Benchmark(const Config &config)
+	: settings(config)
+{ }
+
+const Benchmark::Config &Benchmark::config() const
+{
+	return settings;
+}
+
+const QVector<Benchmark::Series> &Benchmark::results() const
+{
+	return series;
+}
+
+bool Benchmark::empty() const
+{
+	return series.isEmpty();
+}
+
+void Benchmark::run(const QColor &color)
+{
+	series.clear();
+	if (settings.angles.isEmpty() || settings.trials < 1)
+		return;
+
+	QVector<QVector<QLine>> lines;
+	for (int length : settings.lengths())
+		lines.append(spokes(length, settings.angles));
+
+	QColor pen = color;
+	QImage image(SIZE, SIZE, QImage::Format_ARGB32);
+	image.fill(Qt::black);
+	Canvas canvas = { &image, &pen };
+	ChecksumSink checksum(pen.rgb());
+
+	for (const Algorithm &algorithm : lineAlgorithms()) {
+		Series full = { algorithm.name, algorithm.color, true, {}, {}, {} };
+		measure(algorithm.draw, canvas, settings, lines, full);
+		series.append(full);
+
+		Series compute = { algorithm.name, algorithm.color, false, {}, {}, {} };
+		measure(algorithm.compute, checksum, settings, lines, compute);
+		series.append(compute);
+	}
+
+	// Тот же холст, что и у остальных алгоритмов, и один QPainter на весь замер
+	PainterSession session(canvas);
+	Series qt = { "Default (Qt)", QColor(0, 0xff, 0xff), true, {}, {}, {} };
+	measure(defaultQtCore, *canvas.painter, settings, lines, qt);
+	series.append(qt);
+}
+
+QString Benchmark::buildId()
+{
+	QString compiler = "unknown compiler";
+#ifdef __VERSION__
+	compiler = __VERSION__;
+#endif
+	return QString("%1 %2, %3, Qt %4").arg(__DATE__).arg(__TIME__).arg(compiler).arg(QT_VERSION_STR);
+}
+
+QString Benchmark::cpuId()
+{
+	QString model;
+	QFile cpuinfo("/proc/cpuinfo");
+	if (cpuinfo.open(QIODevice::ReadOnly | QIODevice::Text))
+		for (const QByteArray &line : cpuinfo.readAll().split('\n'))
+			if (line.startsWith("model name")) {
+				model = QString::fromUtf8(line.mid(line.indexOf(':') + 1)).trimmed();
+				break;
+			}
+	if (model.isEmpty())
+		model = QSysInfo::currentCpuArchitecture();
+	return QString("%1, %2 threads").arg(model).arg(QThread::idealThreadCount());
+}
+
+QString Benchmark::cachePath() const
+{
+	const QByteArray key = (buildId() + '\n' + cpuId() + '\n' + settings.key()).toUtf8();
+	const QString hash = QCryptographicHash::hash(key, QCryptographicHash::Sha1).toHex().left(16);
+	return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/benchmark-" + hash + ".json";
+}
+
+bool Benchmark::loadCache()
+{
+	QFile file(cachePath());
+	return file.open(QIODevice::ReadOnly) && fromJson(file.readAll());
+}
+
+bool Benchmark::saveCache() const
+{
+	const QString path = cachePath();
+	QDir().mkpath(QFileInfo(path).absolutePath());
+	QFile file(path);
+	return file.open(QIODevice::WriteOnly) && file.write(toJson()) != -1;
+}
+
+QByteArray Benchmark::toJson() const
+{
+	QJsonArray angles;
+	for (int angle : settings.angles)
+		angles.append(angle);
+	QJsonObject config;
+	config["minLength"] = settings.minLength;
+	config["maxLength"] = settings.maxLength;
+	config["lengthStep"] = settings.lengthStep;
+	config["angles"] = angles;
+	config["repeats"] = settings.repeats;
+	config["trials"] = settings.trials;
+	config["warmup"] = settings.warmup;
+
+	QJsonArray results;
+	for (const Series &s : series) {
+		QJsonObject item;
+		item["name"] = s.name;
+		item["color"] = s.color.name();
+		item["output"] = s.output;
+		item["median"] = toArray(s.median);
+		item["p10"] = toArray(s.p10);
+		item["p90"] = toArray(s.p90);
+		results.append(item);
+	}
+
+	QJsonObject root;
+	root["build"] = buildId();
+	root["cpu"] = cpuId();
+	root["config"] = config;
+	root["series"] = results;
+	return QJsonDocument(root).toJson();
+}
+
+// Настройки должны совпасть с текущими: иначе это результаты другого замера
+bool Benchmark::fromJson(const QByteArray &json)
+{
+	const QJsonObject root = QJsonDocument::fromJson(json).object();
+	const QJsonObject config = root["config"].toObject();
+
+	Config loaded;
+	loaded.minLength = config["minLength"].toInt();
+	loaded.maxLength = config["maxLength"].toInt();
+	loaded.lengthStep = config["lengthStep"].toInt();
+	loaded.angles.clear();
+	for (const QJsonValue &angle : config["angles"].toArray())
+		loaded.angles.append(angle.toInt());
+	loaded.repeats = config["repeats"].toInt();
+	loaded.trials = config["trials"].toInt();
+	loaded.warmup = config["warmup"].toInt();
+	if (loaded.key() != settings.key())
+		return false;
+
+	const int points = settings.lengths().size();
+	QVector<Series> results;
+	for (const QJsonValue &value : root["series"].toArray()) {
+		const QJsonObject item = value.toObject();
+		const Series s = {
+			item["name"].toString(), QColor(item["color"].toString()), item["output"].toBool(),
+			fromArray(item["median"]), fromArray(item["p10"]), fromArray(item["p90"])
+		};
+		if (s.median.size() != points || s.p10.size() != points || s.p90.size() != points)
+			return false;
+		results.append(s);
+	}
+	if (results.isEmpty())
+		return false;
+
+	series = results;
+	return true;
+}
+
+void Benchmark::writeCsv(QTextStream &out) const
+{
+	const QVector<int> lengths = settings.lengths();
+	out << "algorithm,output,length,median_ns,p10_ns,p90_ns\n";
+	for (const Series &s : series)
+		for (int i = 0; i != lengths.size(); ++i)
+			out << '"' << s.name << "\"," << (s.output ? 1 : 0) << ',' << lengths[i] << ','
+			    << s.median[i] << ',' << s.p10[i] << ',' << s.p90[i] << '\n';
+}
@@ -0,0 +1,73 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <QColor>
+#include <QString>
+#include <QTextStream>
+#include <QVector>
+
+// Замер времени построения отрезков всеми алгоритмами.
+//
+// Для каждой длины строятся отрезки из центра изображения под всеми заданными углами: сначала
+// warmup отброшенных испытаний, затем trials испытаний по repeats построений каждого отрезка.
+// Результат — время одного построения (нс): медиана и 10-й и 90-й процентили по испытаниям.
+// Каждый алгоритм замеряется дважды: с записью в изображение и без неё (ChecksumSink).
+class Benchmark {
+public:
+	struct Config {
+		int minLength;
+		int maxLength;
+		int lengthStep;
+		// градусы
+		QVector<int> angles;
+		int repeats;
+		int trials;
+		int warmup;
+
+		Config();
+
+		QVector<int> lengths() const;
+		// Текстовая запись всех полей, часть ключа кэша
+		QString key() const;
+	};
+
+	struct Series {
+		QString name;
+		QColor color;
+		// с записью в изображение
+		bool output;
+		// по одному значению на длину
+		QVector<double> median;
+		QVector<double> p10;
+		QVector<double> p90;
+	};
+
+	explicit Benchmark(const Config &config = Config());
+
+	const Config &config() const;
+	const QVector<Series> &results() const;
+	bool empty() const;
+
+	void run(const QColor &color);
+
+	// Кэш результатов на диске: файл зависит от сборки, процессора и настроек
+	QString cachePath() const;
+	bool loadCache();
+	bool saveCache() const;
+
+	QByteArray toJson() const;
+	bool fromJson(const QByteArray &json);
+	// Строка на алгоритм и длину
+	void writeCsv(QTextStream &out) const;
+
+	// Время сборки и компилятор: алгоритмы — шаблоны из lineimpl.h, и при их изменении
+	// benchmark.cpp пересобирается
+	static QString buildId();
+	static QString cpuId();
+
+private:
+	Config settings;
+	QVector<Series> series;
+};
+
+#endif // BENCHMARK_H
@@ -2,10 +2,70 @@
 #define CANVAS_H
 
 #include <QImage>
+#include <QPainter>
+#include <memory>
+
+// Прямой доступ к пикселям изображения (только Format_RGB32 и Format_ARGB32): изображение
+// отсоединяется и цвет упаковывается один раз на отрезок, а не на каждый setPixel.
+// Пиксель (x, y) лежит в bits[y * pitch + x]. Используется через ImageSink (pixelsink.h).
+struct Pixels {
+	QRgb *bits;
+	int pitch;
+	int width;
+	int height;
+	QRgb color;
+
+};
 
 struct Canvas {
 	QImage *image;
 	QColor *color;
+	// QPainter открытого PainterSession, иначе nullptr
+	QPainter *painter;
+
+	Pixels pixels() const {
+		const Pixels result = {
+			reinterpret_cast<QRgb *>(image->bits()),
+			image->bytesPerLine() / int(sizeof(QRgb)),
+			image->width(),
+			image->height(),
+			color->rgb()
+		};
+		return result;
+	}
+};
+
+// Рисование стандартными средствами Qt прямо в изображение холста, без копий в QPixmap и обратно.
+// Пока сеанс открыт, defaultQt рисует все примитивы одним QPainter; вложенный сеанс ничего не
+// делает, а изображение окончательно обновляется при закрытии внешнего.
+class PainterSession {
+public:
+	explicit PainterSession(Canvas &canvas)
+		: canvas(canvas)
+		, owner(!canvas.painter)
+	{
+		if (owner) {
+			painter.reset(new QPainter(canvas.image));
+			painter->setPen(*canvas.color);
+			canvas.painter = painter.get();
+		}
+	}
+
+	~PainterSession()
+	{
+		if (owner) {
+			painter->end();
+			canvas.painter = nullptr;
+		}
+	}
+
+private:
+	Q_DISABLE_COPY(PainterSession)
+
+	Canvas &canvas;
+	bool owner;
+	// в куче: холст живёт дольше сеанса и не должен хранить адрес его поля
+	std::unique_ptr<QPainter> painter;
 };
 
 #endif // CANVAS_H
@@ -0,0 +1,269 @@
+#include "comparison.h"
+#include "algorithms.h"
+
+#include <QPainter>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+// Пиксел в координатах отрезка: major — по основной оси, minor — по второй
+struct Pixel {
+	int major;
+	int minor;
+	int alpha;
+};
+
+static bool operator<(const Pixel &a, const Pixel &b)
+{
+	return a.major != b.major ? a.major < b.major : a.minor < b.minor;
+}
+
+// Пиксел изображения, построенный только одним из алгоритмов
+struct Mismatch {
+	int offset;
+	bool first;
+};
+
+// Стандартный алгоритм Qt: отрезок рисуется в прозрачное изображение размером с его рамку (с полем
+// в пиксел), и все непрозрачные пикселы выводятся в приёмник
+static bool recordQt(const QLine &line, RecordSink &sink)
+{
+	const int left = qMin(line.x1(), line.x2()) - 1;
+	const int top = qMin(line.y1(), line.y2()) - 1;
+	QImage image(qAbs(line.dx()) + 3, qAbs(line.dy()) + 3, QImage::Format_ARGB32);
+	image.fill(Qt::transparent);
+
+	QPainter painter(&image);
+	painter.setPen(QColor(sink.color()));
+	painter.translate(-left, -top);
+	painter.drawLine(line);
+	painter.end();
+
+	for (int y = 0; y != image.height(); ++y) {
+		const QRgb *row = reinterpret_cast<const QRgb *>(image.constScanLine(y));
+		for (int x = 0; x != image.width(); ++x)
+			if (qAlpha(row[x]))
+				sink.plot(left + x, top + y, row[x]);
+	}
+	return true;
+}
+
+// Пикселы отрезка по возрастанию без повторов (у повторённого — наибольшая интенсивность);
+// пикселы с нулевой интенсивностью отбрасываются
+static QVector<Pixel> pixelSet(const RecordSink &sink, bool steep)
+{
+	QVector<Pixel> pixels;
+	pixels.reserve(sink.plots.size());
+	for (const RecordSink::Plot &plot : sink.plots) {
+		const int alpha = qAlpha(plot.color);
+		if (alpha)
+			pixels.append(steep ? Pixel{ plot.y, plot.x, alpha } : Pixel{ plot.x, plot.y, alpha });
+	}
+	std::sort(pixels.begin(), pixels.end());
+
+	int count = 0;
+	for (const Pixel &pixel : pixels)
+		if (count && !(pixels[count - 1] < pixel))
+			pixels[count - 1].alpha = qMax(pixels[count - 1].alpha, pixel.alpha);
+		else
+			pixels[count++] = pixel;
+	pixels.resize(count);
+	return pixels;
+}
+
+// Расстояние от точки p до отрезка ab
+static double distance(const QPointF &p, const QPointF &a, const QPointF &b)
+{
+	const QPointF ab = b - a;
+	const double length2 = QPointF::dotProduct(ab, ab);
+	const double t = length2 ? qBound(0.0, QPointF::dotProduct(p - a, ab) / length2, 1.0) : 0;
+	const QPointF d = p - a - t * ab;
+	return std::sqrt(QPointF::dotProduct(d, d));
+}
+
+struct Trace {
+	double deviation;
+	int stairs;
+};
+
+// След по пикселам pixelSet; из равных по интенсивности в след идёт ближний к отрезку ab
+static Trace trace(const QVector<Pixel> &pixels, const QPointF &a, const QPointF &b)
+{
+	Trace result = { 0, 0 };
+	int previous = 0;
+	for (int i = 0; i != pixels.size(); ) {
+		int best = i;
+		double bestDistance = distance(QPointF(pixels[i].major, pixels[i].minor), a, b);
+		int next = i + 1;
+		for (; next != pixels.size() && pixels[next].major == pixels[i].major; ++next) {
+			const double d = distance(QPointF(pixels[next].major, pixels[next].minor), a, b);
+			if (pixels[next].alpha > pixels[best].alpha
+			    || (pixels[next].alpha == pixels[best].alpha && d < bestDistance)) {
+				best = next;
+				bestDistance = d;
+			}
+		}
+
+		result.deviation = qMax(result.deviation, bestDistance);
+		if (i && pixels[best].minor != previous)
+			++result.stairs;
+		previous = pixels[best].minor;
+		i = next;
+	}
+	return result;
+}
+
+const QVector<Comparison::Source> &Comparison::sources()
+{
+	static const QVector<Source> all = [] {
+		QVector<Source> result;
+		for (const Algorithm &algorithm : lineAlgorithms())
+			result.append({ algorithm.name, algorithm.record });
+		result.append({ "Default (Qt)", recordQt });
+		return result;
+	}();
+	return all;
+}
+
+Comparison::Config::Config()
+	: minLength(1)
+	, maxLength(100)
+	, lengthStep(1)
+	, angleStep(1)
+{ }
+
+QVector<int> Comparison::Config::lengths() const
+{
+	QVector<int> result;
+	for (int length = minLength; length <= maxLength; length += qMax(1, lengthStep))
+		result.append(length);
+	return result;
+}
+
+QVector<int> Comparison::Config::angles() const
+{
+	QVector<int> result;
+	for (int angle = 0; angle < 360; angle += qMax(1, angleStep))
+		result.append(angle);
+	return result;
+}
+
+Comparison::Comparison(const Config &config)
+	: settings(config)
+{ }
+
+void Comparison::run(const Source &first, const Source &second)
+{
+	const QVector<int> degrees = settings.angles();
+	const QVector<int> lengths = settings.lengths();
+	angles = QVector<Angle>(degrees.size());
+	QVector<QVector<Mismatch>> mismatches(degrees.size());
+
+	QVector<int> indices(degrees.size());
+	std::iota(indices.begin(), indices.end(), 0);
+	QtConcurrent::blockingMap(indices.begin(), indices.end(), [&](int index) {
+		Angle &result = angles[index];
+		result = { degrees[index], 0, 0, 0, { 0, 0 }, { 0, 0 } };
+		const double radians = degrees[index] * M_PI / 180;
+
+		for (int length : lengths) {
+			const QLine line(CENTER, CENTER,
+			                 CENTER + qRound(length * std::cos(radians)),
+			                 CENTER - qRound(length * std::sin(radians)));
+			const bool steep = qAbs(line.dy()) > qAbs(line.dx());
+			const QPointF a = steep ? QPointF(line.y1(), line.x1()) : QPointF(line.x1(), line.y1());
+			const QPointF b = steep ? QPointF(line.y2(), line.x2()) : QPointF(line.x2(), line.y2());
+
+			RecordSink sinks[2] = { RecordSink(qRgb(0xff, 0xff, 0xff)), RecordSink(qRgb(0xff, 0xff, 0xff)) };
+			first.record(line, sinks[0]);
+			second.record(line, sinks[1]);
+
+			QVector<Pixel> pixels[2];
+			for (int k = 0; k != 2; ++k) {
+				pixels[k] = pixelSet(sinks[k], steep);
+				const Trace t = trace(pixels[k], a, b);
+				result.deviation[k] = qMax(result.deviation[k], t.deviation);
+				result.stairs[k] += t.stairs;
+			}
+
+			// Слияние двух упорядоченных множеств
+			qint64 count = 0;
+			const auto mismatch = [&](const Pixel &pixel, bool inFirst) {
+				++count;
+				const int x = steep ? pixel.minor : pixel.major;
+				const int y = steep ? pixel.major : pixel.minor;
+				if (uint(x) < uint(SIZE) && uint(y) < uint(SIZE))
+					mismatches[index].append({ y * SIZE + x, inFirst });
+			};
+			int i = 0;
+			int j = 0;
+			while (i != pixels[0].size() || j != pixels[1].size()) {
+				if (j == pixels[1].size() || (i != pixels[0].size() && pixels[0][i] < pixels[1][j]))
+					mismatch(pixels[0][i++], true);
+				else if (i == pixels[0].size() || pixels[1][j] < pixels[0][i])
+					mismatch(pixels[1][j++], false);
+				else {
+					++i;
+					++j;
+				}
+			}
+
+			++result.lines;
+			if (count)
+				++result.mismatchedLines;
+			result.mismatches += count;
+		}
+	});
+
+	onlyFirst.fill(0, SIZE * SIZE);
+	onlySecond.fill(0, SIZE * SIZE);
+	for (const QVector<Mismatch> &angle : mismatches)
+		for (const Mismatch &m : angle)
+			++(m.first ? onlyFirst : onlySecond)[m.offset];
+}
+
+const QVector<Comparison::Angle> &Comparison::results() const
+{
+	return angles;
+}
+
+// degrees у итога — -1
+Comparison::Angle Comparison::total() const
+{
+	Angle result = { -1, 0, 0, 0, { 0, 0 }, { 0, 0 } };
+	for (const Angle &angle : angles) {
+		result.lines += angle.lines;
+		result.mismatchedLines += angle.mismatchedLines;
+		result.mismatches += angle.mismatches;
+		for (int k = 0; k != 2; ++k) {
+			result.deviation[k] = qMax(result.deviation[k], angle.deviation[k]);
+			result.stairs[k] += angle.stairs[k];
+		}
+	}
+	return result;
+}
+
+QImage Comparison::heatmap() const
+{
+	QImage image(SIZE, SIZE, QImage::Format_RGB32);
+	image.fill(Qt::black);
+	if (onlyFirst.isEmpty())
+		return image;
+
+	const int most = qMax(*std::max_element(onlyFirst.begin(), onlyFirst.end()),
+	                      *std::max_element(onlySecond.begin(), onlySecond.end()));
+	if (!most)
+		return image;
+
+	// Одиночное расхождение тоже должно быть видно: яркость от 64 до 255
+	const double scale = 191 / std::log(1.0 + most);
+	const auto level = [scale](int count) { return count ? 64 + qRound(std::log(1.0 + count) * scale) : 0; };
+	for (int y = 0; y != SIZE; ++y) {
+		QRgb *row = reinterpret_cast<QRgb *>(image.scanLine(y));
+		for (int x = 0; x != SIZE; ++x)
+			row[x] = qRgb(level(onlyFirst[y * SIZE + x]), 0, level(onlySecond[y * SIZE + x]));
+	}
+	return image;
+}
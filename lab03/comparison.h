@@ -0,0 +1,82 @@
+#ifndef COMPARISON_H
+#define COMPARISON_H
+
+#include <QImage>
+#include <QString>
+#include <QVector>
+
+#include "pixelsink.h"
+
+// Сравнение пикселов двух алгоритмов построения отрезков — та же проверка, что рисование другим
+// цветом поверх, но на тысячах отрезков сразу.
+//
+// Отрезки всех длин идут из центра изображения под углами 0, angleStep, ... < 360. Каждый отрезок
+// строится обоими алгоритмами в RecordSink, и пикселы с ненулевой интенсивностью сравниваются как
+// множества. Углы обрабатываются параллельно.
+//
+// След алгоритма — самый яркий пиксел на каждой координате основной оси отрезка. По следу
+// считаются отклонение (расстояние от центра пиксела до идеального отрезка) и ступеньки (смены
+// второй координаты); у алгоритмов без сглаживания след — это все их пикселы.
+class Comparison {
+public:
+	typedef bool (*Record)(const QLine &line, RecordSink &sink);
+
+	struct Source {
+		QString name;
+		Record record;
+	};
+
+	struct Config {
+		int minLength;
+		int maxLength;
+		int lengthStep;
+		int angleStep;
+
+		Config();
+
+		QVector<int> lengths() const;
+		QVector<int> angles() const;
+	};
+
+	// Итоги по углу, индекс [0] или [1] — первый или второй алгоритм
+	struct Angle {
+		int degrees;
+		int lines;
+		// отрезков, у которых пикселы не совпали
+		int mismatchedLines;
+		// пикселов, построенных только одним из алгоритмов
+		qint64 mismatches;
+		// наибольшее отклонение следа по всем отрезкам
+		double deviation[2];
+		// ступенек на всех отрезках
+		qint64 stairs[2];
+	};
+
+	// Изображение, на котором строятся отрезки, — как у MainWindow
+	static const int CENTER = 360;
+	static const int SIZE = 2 * CENTER + 1;
+
+	// Все алгоритмы lineAlgorithms() и стандартный алгоритм Qt
+	static const QVector<Source> &sources();
+
+	explicit Comparison(const Config &config = Config());
+
+	void run(const Source &first, const Source &second);
+
+	const QVector<Angle> &results() const;
+	// Итог по всем углам
+	Angle total() const;
+
+	// Пикселы, построенные только первым алгоритмом, — красные, только вторым — синие; яркость
+	// растёт с логарифмом числа таких отрезков
+	QImage heatmap() const;
+
+private:
+	Config settings;
+	QVector<Angle> angles;
+	// по пикселу изображения, y * SIZE + x
+	QVector<int> onlyFirst;
+	QVector<int> onlySecond;
+};
+
+#endif // COMPARISON_H
@@ -0,0 +1,91 @@
+#include "comparisondialog.h"
+#include "ui_comparisondialog.h"
+
+#include <QApplication>
+#include <QElapsedTimer>
+
+ComparisonDialog::ComparisonDialog(QWidget *parent) :
+	QDialog(parent),
+	ui(new Ui::ComparisonDialog)
+{
+	ui->setupUi(this);
+
+	for (const Comparison::Source &source : Comparison::sources()) {
+		ui->firstComboBox->addItem(source.name);
+		ui->secondComboBox->addItem(source.name);
+	}
+	// Проверка из задания: свой алгоритм против стандартного
+	ui->firstComboBox->setCurrentText("Bresenham (integer)");
+	ui->secondComboBox->setCurrentText("Default (Qt)");
+
+	const Comparison::Config defaults;
+	ui->minLengthSpinBox->setValue(defaults.minLength);
+	ui->maxLengthSpinBox->setValue(defaults.maxLength);
+	ui->lengthStepSpinBox->setValue(defaults.lengthStep);
+	ui->angleStepSpinBox->setValue(defaults.angleStep);
+
+	ui->tableWidget->setColumnCount(8);
+	ui->tableWidget->setHorizontalHeaderLabels({ "angle", "lines", "mismatched lines", "mismatched pixels",
+	                                             "deviation 1", "deviation 2", "stairs 1", "stairs 2" });
+}
+
+ComparisonDialog::~ComparisonDialog()
+{
+	delete ui;
+}
+
+Comparison::Config ComparisonDialog::config() const
+{
+	Comparison::Config result;
+	result.minLength = ui->minLengthSpinBox->value();
+	result.maxLength = ui->maxLengthSpinBox->value();
+	result.lengthStep = ui->lengthStepSpinBox->value();
+	result.angleStep = ui->angleStepSpinBox->value();
+	return result;
+}
+
+void ComparisonDialog::setRow(int row, const QString &angle, const Comparison::Angle &result)
+{
+	const QStringList cells = {
+		angle,
+		QString::number(result.lines),
+		QString::number(result.mismatchedLines),
+		QString::number(result.mismatches),
+		QString::number(result.deviation[0], 'f', 3),
+		QString::number(result.deviation[1], 'f', 3),
+		QString::number(result.stairs[0]),
+		QString::number(result.stairs[1])
+	};
+	for (int column = 0; column != cells.size(); ++column)
+		ui->tableWidget->setItem(row, column, new QTableWidgetItem(cells[column]));
+}
+
+void ComparisonDialog::on_runPushButton_clicked()
+{
+	const Comparison::Source &first = Comparison::sources()[ui->firstComboBox->currentIndex()];
+	const Comparison::Source &second = Comparison::sources()[ui->secondComboBox->currentIndex()];
+
+	QApplication::setOverrideCursor(Qt::WaitCursor);
+	QElapsedTimer timer;
+	timer.start();
+
+	Comparison comparison(config());
+	comparison.run(first, second);
+
+	QApplication::restoreOverrideCursor();
+
+	const Comparison::Angle total = comparison.total();
+	ui->statusLabel->setText(QString("%1 lines in %2 s: %3 do not coincide, %4 pixels differ "
+	                                 "(red — only %5, blue — only %6)")
+	                         .arg(total.lines).arg(timer.elapsed() / 1000.0, 0, 'f', 1)
+	                         .arg(total.mismatchedLines).arg(total.mismatches)
+	                         .arg(first.name).arg(second.name));
+
+	const QVector<Comparison::Angle> &results = comparison.results();
+	ui->tableWidget->setRowCount(1 + results.size());
+	setRow(0, "all", total);
+	for (int i = 0; i != results.size(); ++i)
+		setRow(1 + i, QString::number(results[i].degrees), results[i]);
+
+	ui->heatmapLabel->setPixmap(QPixmap::fromImage(comparison.heatmap()));
+}
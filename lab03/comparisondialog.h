@@ -0,0 +1,32 @@
+#ifndef COMPARISONDIALOG_H
+#define COMPARISONDIALOG_H
+
+#include <QDialog>
+
+#include "comparison.h"
+
+namespace Ui {
+class ComparisonDialog;
+}
+
+// Совпадение пикселов двух алгоритмов на спектре отрезков: таблица по углам (первая строка —
+// итог) и карта расхождений
+class ComparisonDialog : public QDialog
+{
+	Q_OBJECT
+
+public:
+	explicit ComparisonDialog(QWidget *parent = 0);
+	~ComparisonDialog();
+
+private slots:
+	void on_runPushButton_clicked();
+
+private:
+	Comparison::Config config() const;
+	void setRow(int row, const QString &angle, const Comparison::Angle &result);
+
+	Ui::ComparisonDialog *ui;
+};
+
+#endif // COMPARISONDIALOG_H
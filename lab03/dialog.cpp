@@ -1,30 +1,18 @@
 #include "dialog.h"
 #include "ui_dialog.h"
 
-#include <algorithm>
+#include <QFile>
+#include <QFileDialog>
+#include <QRegularExpression>
+#include <QtConcurrent>
 
-Dialog::Dialog(const QVector<QVector<double>> &ns, int M, QWidget *parent) :
+Dialog::Dialog(const QColor &color, QWidget *parent) :
 	QDialog(parent),
-	ui(new Ui::Dialog)
+	ui(new Ui::Dialog),
+	color(color)
 {
 	ui->setupUi(this);
 
-	ui->customPlot->addGraph();
-	ui->customPlot->graph(0)->setPen(QPen(QColor(0, 0, 0xff), 2));
-	ui->customPlot->addGraph();
-	ui->customPlot->graph(1)->setPen(QPen(QColor(0, 0xff, 0), 2));
-	ui->customPlot->addGraph();
-	ui->customPlot->graph(2)->setPen(QPen(QColor(0xff, 0, 0xff), 2));
-	ui->customPlot->addGraph();
-	ui->customPlot->graph(3)->setPen(QPen(QColor(0xff, 0, 0), 2));
-	ui->customPlot->addGraph();
-	ui->customPlot->graph(4)->setPen(QPen(Qt::gray, 2));
-	ui->customPlot->addGraph();
-	ui->customPlot->graph(5)->setPen(QPen(QColor(0, 0xff, 0xff), 2));
-
-	QVector<double> x(M);
-	for (int i = 0; i != M; ++i)
-		x[i] = i + 1;
 	// configure right and top axis to show ticks but no labels:
 	// (see QCPAxisRect::setupFullAxesBox for a quicker method to do this)
 	ui->customPlot->xAxis2->setVisible(true);
@@ -36,26 +24,6 @@ Dialog::Dialog(const QVector<QVector<double>> &ns, int M, QWidget *parent) :
 	// make left and bottom axes always transfer their ranges to right and top axes:
 	connect(ui->customPlot->xAxis, SIGNAL(rangeChanged(QCPRange)), ui->customPlot->xAxis2, SLOT(setRange(QCPRange)));
 	connect(ui->customPlot->yAxis, SIGNAL(rangeChanged(QCPRange)), ui->customPlot->yAxis2, SLOT(setRange(QCPRange)));
-	// pass data points to graphs:
-	ui->customPlot->graph(0)->setData(x, ns[0]);
-	ui->customPlot->graph(1)->setData(x, ns[1]);
-	ui->customPlot->graph(2)->setData(x, ns[2]);
-	ui->customPlot->graph(3)->setData(x, ns[3]);
-	ui->customPlot->graph(4)->setData(x, ns[4]);
-	ui->customPlot->graph(5)->setData(x, ns[5]);
-
-	ui->customPlot->graph(0)->setName("DDA");
-	ui->customPlot->graph(1)->setName("Bresenham (float)");
-	ui->customPlot->graph(2)->setName("Bresenham (integer)");
-	ui->customPlot->graph(3)->setName("Bresenham (anti-aliased)");
-	ui->customPlot->graph(4)->setName("Wu");
-	ui->customPlot->graph(5)->setName("Default (Qt)");
-
-	// let the ranges scale themselves so graph 0 fits perfectly in the visible area:
-	ui->customPlot->graph(0)->rescaleAxes();
-	// same thing for graph 1, but only enlarge ranges (in case graph 1 is smaller than graph 0):
-	ui->customPlot->graph(1)->rescaleAxes(true);
-	// Note: we could have also just called ui->customPlot->rescaleAxes(); instead
 	// Allow user to drag axis ranges with mouse, zoom with mouse wheel and select graphs by clicking:
 	ui->customPlot->setInteractions(QCP::iRangeDrag | QCP::iRangeZoom | QCP::iSelectPlottables);
 
@@ -68,9 +36,167 @@ Dialog::Dialog(const QVector<QVector<double>> &ns, int M, QWidget *parent) :
 	legendFont.setPointSize(10);
 	ui->customPlot->legend->setFont(legendFont);
 	ui->customPlot->setInteractions(QCP::iRangeDrag | QCP::iRangeZoom);
+
+	// другие настройки — другой файл кэша
+	const Benchmark::Config defaults;
+	ui->minLengthSpinBox->setValue(defaults.minLength);
+	ui->maxLengthSpinBox->setValue(defaults.maxLength);
+	ui->lengthStepSpinBox->setValue(defaults.lengthStep);
+	QStringList angles;
+	for (int angle : defaults.angles)
+		angles.append(QString::number(angle));
+	ui->anglesLineEdit->setText(angles.join(", "));
+	ui->repeatsSpinBox->setValue(defaults.repeats);
+	ui->trialsSpinBox->setValue(defaults.trials);
+	ui->warmupSpinBox->setValue(defaults.warmup);
+
+	for (QSpinBox *spinBox : { ui->minLengthSpinBox, ui->maxLengthSpinBox, ui->lengthStepSpinBox,
+	                           ui->repeatsSpinBox, ui->trialsSpinBox, ui->warmupSpinBox })
+		connect(spinBox, SIGNAL(valueChanged(int)), this, SLOT(loadCache()));
+	connect(ui->anglesLineEdit, SIGNAL(editingFinished()), this, SLOT(loadCache()));
+	connect(&runWatcher, SIGNAL(finished()), this, SLOT(runFinished()));
+
+	loadCache();
 }
 
 Dialog::~Dialog()
 {
+	// замер не прерывается, диалог закрывается после него
+	runWatcher.waitForFinished();
 	delete ui;
 }
+
+Benchmark::Config Dialog::config() const
+{
+	Benchmark::Config result;
+	result.minLength = ui->minLengthSpinBox->value();
+	result.maxLength = ui->maxLengthSpinBox->value();
+	result.lengthStep = ui->lengthStepSpinBox->value();
+	result.angles.clear();
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+	const Qt::SplitBehavior skipEmpty = Qt::SkipEmptyParts;
+#else
+	const QString::SplitBehavior skipEmpty = QString::SkipEmptyParts;
+#endif
+	for (const QString &angle : ui->anglesLineEdit->text().split(QRegularExpression("[,\\s]+"), skipEmpty)) {
+		bool ok = false;
+		const int degrees = angle.toInt(&ok);
+		if (ok)
+			result.angles.append(degrees);
+	}
+	result.repeats = ui->repeatsSpinBox->value();
+	result.trials = ui->trialsSpinBox->value();
+	result.warmup = ui->warmupSpinBox->value();
+	return result;
+}
+
+void Dialog::loadCache()
+{
+	benchmark = Benchmark(config());
+	if (benchmark.loadCache())
+		ui->statusLabel->setText("Loaded from " + benchmark.cachePath());
+	else
+		ui->statusLabel->setText("Not measured with these settings on this build and CPU yet");
+	plot();
+}
+
+void Dialog::on_runPushButton_clicked()
+{
+	if (runWatcher.isRunning())
+		return;
+
+	setSettingsEnabled(false);
+	ui->statusLabel->setText("Measuring...");
+	runTimer.start();
+
+	const Benchmark::Config settings = config();
+	const QColor color = this->color;
+	runWatcher.setFuture(QtConcurrent::run([settings, color]() {
+		Benchmark result(settings);
+		result.run(color);
+		return result;
+	}));
+}
+
+void Dialog::runFinished()
+{
+	benchmark = runWatcher.result();
+	const bool saved = benchmark.saveCache();
+
+	setSettingsEnabled(true);
+	ui->statusLabel->setText(QString("Measured in %1 s%2").arg(runTimer.elapsed() / 1000.0, 0, 'f', 1)
+	                         .arg(saved ? ", saved to " + benchmark.cachePath() : ", cache not written"));
+	plot();
+}
+
+void Dialog::setSettingsEnabled(bool enabled)
+{
+	for (QWidget *widget : std::initializer_list<QWidget *>{
+	         ui->minLengthSpinBox, ui->maxLengthSpinBox, ui->lengthStepSpinBox, ui->anglesLineEdit,
+	         ui->repeatsSpinBox, ui->trialsSpinBox, ui->warmupSpinBox, ui->runPushButton })
+		widget->setEnabled(enabled);
+}
+
+void Dialog::on_exportPushButton_clicked()
+{
+	if (benchmark.empty())
+		return;
+
+	QString selected;
+	const QString path = QFileDialog::getSaveFileName(this, "Export results", "benchmark.csv",
+	                                                  "CSV (*.csv);;JSON (*.json)", &selected);
+	if (path.isEmpty())
+		return;
+
+	QFile file(path);
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+		ui->statusLabel->setText("Can not write " + path);
+		return;
+	}
+	if (path.endsWith(".json", Qt::CaseInsensitive) || selected.startsWith("JSON"))
+		file.write(benchmark.toJson());
+	else {
+		QTextStream out(&file);
+		benchmark.writeCsv(out);
+	}
+	file.close();
+
+	if (file.error() != QFileDevice::NoError)
+		ui->statusLabel->setText("Can not write " + path);
+	else
+		ui->statusLabel->setText("Exported to " + path);
+}
+
+// Для каждого алгоритма два графика медианы: сплошной — построение с записью в изображение,
+// пунктир — те же вычисления без записи (ChecksumSink); разница между ними — стоимость вывода.
+void Dialog::plot()
+{
+	ui->customPlot->clearGraphs();
+
+	QVector<double> x;
+	for (int length : benchmark.config().lengths())
+		x.append(length);
+
+	const QVector<Benchmark::Series> &results = benchmark.results();
+	for (const Benchmark::Series &series : results) {
+		QString name = series.name;
+		if (!series.output)
+			name += ", no output";
+		else
+			for (const Benchmark::Series &compute : results)
+				if (!compute.output && compute.name == series.name && !series.median.isEmpty()) {
+					// доля записи для самого длинного отрезка
+					const double output = qMax(0.0, 1 - compute.median.last() / series.median.last());
+					name = QString("%1 (output %2%)").arg(series.name).arg(qRound(100 * output));
+				}
+
+		QCPGraph *graph = ui->customPlot->addGraph();
+		graph->setPen(series.output ? QPen(series.color, 2) : QPen(series.color, 1, Qt::DashLine));
+		graph->setData(x, series.median);
+		graph->setName(name);
+	}
+
+	// let the ranges scale themselves so all graphs fit in the visible area:
+	ui->customPlot->rescaleAxes();
+	ui->customPlot->replot();
+}
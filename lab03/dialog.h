@@ -2,21 +2,43 @@
 #define DIALOG_H
 
 #include <QDialog>
+#include <QElapsedTimer>
+#include <QFutureWatcher>
+
+#include "benchmark.h"
 
 namespace Ui {
 class Dialog;
 }
 
+// Графики времени построения отрезков. Результаты для текущих настроек берутся из кэша, если
+// они там есть, и замеряются заново по кнопке Run в отдельном потоке.
 class Dialog : public QDialog
 {
 	Q_OBJECT
 
 public:
-	explicit Dialog(const QVector<QVector<double>> &ns, int M, QWidget *parent = 0);
+	explicit Dialog(const QColor &color, QWidget *parent = 0);
 	~Dialog();
 
+private slots:
+	void on_runPushButton_clicked();
+	void on_exportPushButton_clicked();
+	void loadCache();
+	void runFinished();
+
 private:
+	Benchmark::Config config() const;
+	void plot();
+	void setSettingsEnabled(bool enabled);
+
 	Ui::Dialog *ui;
+
+	QColor color;
+	Benchmark benchmark;
+	// замер с настройками на момент нажатия Run; настройки до его конца заблокированы
+	QFutureWatcher<Benchmark> runWatcher;
+	QElapsedTimer runTimer;
 };
 
 #endif // DIALOG_H
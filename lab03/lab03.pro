@@ -4,7 +4,7 @@
 #
 #-------------------------------------------------
 
-QT       += core gui
+QT       += core gui concurrent
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets printsupport
 
@@ -27,6 +27,11 @@ SOURCES += \
         main.cpp \
         mainwindow.cpp \
     line.cpp \
+    linebatch.cpp \
+    algorithms.cpp \
+    benchmark.cpp \
+    comparison.cpp \
+    comparisondialog.cpp \
     dialog.cpp \
     qcustomplot.cpp
 
@@ -34,9 +39,17 @@ HEADERS += \
         mainwindow.h \
     canvas.h \
     line.h \
+    lineimpl.h \
+    linebatch.h \
+    pixelsink.h \
+    algorithms.h \
+    benchmark.h \
+    comparison.h \
+    comparisondialog.h \
     dialog.h \
     qcustomplot.h
 
 FORMS += \
         mainwindow.ui \
-    dialog.ui
+    dialog.ui \
+    comparisondialog.ui
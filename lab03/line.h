@@ -2,14 +2,67 @@
 #define LINE_H
 
 #include "canvas.h"
+#include "pixelsink.h"
 #include <QPainter>
 
+// Вес смешивания (0..256) для каждой 8-битной интенсивности. При gamma != 1 покрытие i / 255
+// возводится в степень 1 / gamma, и на тёмном и светлом фоне линия выглядит одинаково толстой.
+struct BlendTable {
+	explicit BlendTable(double gamma = 1);
+
+	int weight[256];
+
+	static const BlendTable linear;
+	static const BlendTable corrected;
+};
+
+// Шаги целочисленного алгоритма Брезенхема для всех коротких отрезков, строятся при запуске.
+// Отрезок приводится к первому октанту (0 <= dy <= dx), так что одна таблица служит всем
+// восьми: бит i маски установлен, если после пиксела i меняется не основная координата.
+struct LinePatterns {
+	// Самый длинный отрезок в таблице; не больше 64 — битов в маске
+	enum { LENGTH = 64 };
+
+	LinePatterns();
+
+	quint64 steps(int dx, int dy) const { return masks[dx * (dx + 1) / 2 + dy]; }
+
+	static const LinePatterns table;
+
+private:
+	quint64 masks[(LENGTH + 1) * (LENGTH + 2) / 2];
+};
+
 bool dda(const QLine &line, Canvas &canvas);
+bool ddaFixed(const QLine &line, Canvas &canvas);
+bool ddaSimd(const QLine &line, Canvas &canvas);
 bool bresenhamFloat(const QLine &line, Canvas &canvas);
 bool bresenhamInteger(const QLine &line, Canvas &canvas);
+bool bresenhamRunSlice(const QLine &line, Canvas &canvas);
+bool bresenhamPattern(const QLine &line, Canvas &canvas);
+bool bresenhamDoubleStep(const QLine &line, Canvas &canvas);
 bool bresenhamAntialiased(const QLine &line, Canvas &canvas);
 bool defaultQt(const QLine &line, Canvas &canvas);
 bool defaultQtCore(const QLine &line, QPainter &painter);
 bool wu(const QLine &line, Canvas &canvas);
+bool wuInteger(const QLine &line, Canvas &canvas);
+bool wuInteger(const QLine &line, Canvas &canvas, const BlendTable &table);
+
+// Те же алгоритмы с выводом в произвольный приёмник пикселов (pixelsink.h).
+// Функции с Canvas выше выводят через ImageSink.
+template <typename Sink> bool dda(const QLine &line, Sink &sink);
+template <typename Sink> bool ddaFixed(const QLine &line, Sink &sink);
+template <typename Sink> bool ddaSimd(const QLine &line, Sink &sink);
+template <typename Sink> bool bresenhamFloat(const QLine &line, Sink &sink);
+template <typename Sink> bool bresenhamInteger(const QLine &line, Sink &sink);
+template <typename Sink> bool bresenhamRunSlice(const QLine &line, Sink &sink);
+template <typename Sink> bool bresenhamPattern(const QLine &line, Sink &sink);
+template <typename Sink> bool bresenhamDoubleStep(const QLine &line, Sink &sink);
+template <typename Sink> bool bresenhamAntialiased(const QLine &line, Sink &sink);
+template <typename Sink> bool wu(const QLine &line, Sink &sink);
+template <typename Sink> bool wuInteger(const QLine &line, Sink &sink, const BlendTable &table);
+template <typename Sink> bool wuInteger(const QLine &line, Sink &sink);
+
+#include "lineimpl.h"
 
 #endif // LINE_H
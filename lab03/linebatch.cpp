@@ -0,0 +1,62 @@
+#include "linebatch.h"
+
+#include <QThread>
+#include <QtConcurrent>
+#include <numeric>
+
+// Примерное число пикселов в волне: корзины волны остаются в кэше и переиспользуются
+static const qint64 WAVE_PIXELS = 1 << 18;
+
+void drawLines(const QVector<QLine> &lines, Canvas &canvas, BatchAlgorithm algorithm, QVector<bool> *ok)
+{
+	const Pixels pixels = canvas.pixels();
+	bool *results = nullptr;
+	if (ok) {
+		ok->resize(lines.size());
+		results = ok->data();
+	}
+
+	const int tilesX = (pixels.width + BinSink::TILE_SIZE - 1) >> BinSink::TILE_SHIFT;
+	const int tilesY = (pixels.height + BinSink::TILE_SIZE - 1) >> BinSink::TILE_SHIFT;
+	const int tiles = tilesX * tilesY;
+
+	// Несколько порций на поток, чтобы длинные и короткие отрезки распределились ровнее
+	const int chunks = 4 * qMax(1, QThread::idealThreadCount());
+	// корзина плитки t порции c — bins[c * tiles + t]
+	std::vector<std::vector<BinSink::Entry>> bins(size_t(chunks) * tiles);
+
+	QVector<int> indices(qMax(chunks, tiles));
+	std::iota(indices.begin(), indices.end(), 0);
+
+	for (int waveFirst = 0; waveFirst != lines.size(); ) {
+		int waveLast = waveFirst;
+		for (qint64 estimate = 0; waveLast != lines.size() && estimate < WAVE_PIXELS; ++waveLast)
+			estimate += qMax(qAbs(lines[waveLast].dx()), qAbs(lines[waveLast].dy())) + 1;
+		const int waveLines = waveLast - waveFirst;
+		const int waveChunks = qMin(chunks, waveLines);
+
+		// Порция c — отрезки волны [c * n / chunks, (c + 1) * n / chunks)
+		QtConcurrent::blockingMap(indices.begin(), indices.begin() + waveChunks, [&](int chunk) {
+			std::vector<BinSink::Entry> *chunkBins = &bins[size_t(chunk) * tiles];
+			for (int tile = 0; tile != tiles; ++tile)
+				chunkBins[tile].clear();
+
+			BinSink sink(pixels, chunkBins);
+			const int first = waveFirst + qint64(chunk) * waveLines / waveChunks;
+			const int last = waveFirst + qint64(chunk + 1) * waveLines / waveChunks;
+			for (int i = first; i != last; ++i) {
+				const bool result = algorithm(lines[i], sink);
+				if (results)
+					results[i] = result;
+			}
+		});
+
+		QtConcurrent::blockingMap(indices.begin(), indices.begin() + tiles, [&](int tile) {
+			for (int chunk = 0; chunk != waveChunks; ++chunk)
+				for (const BinSink::Entry &entry : bins[size_t(chunk) * tiles + tile])
+					pixels.bits[entry.offset] = entry.color;
+		});
+
+		waveFirst = waveLast;
+	}
+}
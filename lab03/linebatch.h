@@ -0,0 +1,70 @@
+#ifndef LINEBATCH_H
+#define LINEBATCH_H
+
+#include <QVector>
+#include <vector>
+#include "line.h"
+
+// Приёмник пакетного построения: раскладывает пикселы по корзинам плиток изображения
+// (квадратов TILE_SIZE x TILE_SIZE) в порядке построения
+class BinSink {
+public:
+	static const int TILE_SHIFT = 6;
+	static const int TILE_SIZE = 1 << TILE_SHIFT;
+
+	// Пиксел изображения со смещением offset = y * pitch + x
+	struct Entry {
+		int offset;
+		QRgb color;
+	};
+
+	// bins — по корзине на плитку, плитки по строкам
+	BinSink(const Pixels &pixels, std::vector<Entry> *bins)
+		: bins(bins)
+		, stride(pixels.pitch)
+		, width(pixels.width)
+		, height(pixels.height)
+		, tilesX((pixels.width + TILE_SIZE - 1) >> TILE_SHIFT)
+		, rgb(pixels.color)
+	{ }
+
+	void begin(const QLine &, int = 0) { }
+
+	QRgb color() const { return rgb; }
+	std::ptrdiff_t pitch() const { return 0; }
+
+	void moveTo(int, int) { }
+	void move(std::ptrdiff_t) { }
+
+	void plot(int x, int y, QRgb color)
+	{
+		if (uint(x) < uint(width) && uint(y) < uint(height))
+			bins[(y >> TILE_SHIFT) * tilesX + (x >> TILE_SHIFT)].push_back({ y * stride + x, color });
+	}
+
+	void run(int x, int y, int stepX, int stepY, int count, QRgb color)
+	{
+		for (int i = 0; i != count; ++i, x += stepX, y += stepY)
+			plot(x, y, color);
+	}
+
+private:
+	std::vector<Entry> *bins;
+	int stride;
+	int width;
+	int height;
+	int tilesX;
+	QRgb rgb;
+};
+
+typedef bool (*BatchAlgorithm)(const QLine &line, BinSink &sink);
+
+// Строит отрезки так же, как их построил бы по порядку алгоритм algorithm с Canvas (line.h),
+// но на всех ядрах. Отрезки идут волнами; волна делится на порции, порции параллельно
+// раскладывают свои пикселы по плиткам, затем плитки параллельно записываются в изображение,
+// каждая в порядке отрезков. Плитки не пересекаются, а в каждом пикселе остаётся цвет последнего
+// отрезка, как и при последовательном построении. Если ok не nullptr, (*ok)[i] — результат
+// алгоритма для lines[i].
+void drawLines(const QVector<QLine> &lines, Canvas &canvas, BatchAlgorithm algorithm, QVector<bool> *ok = nullptr);
+
+#endif // LINEBATCH_H
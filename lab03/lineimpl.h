@@ -0,0 +1,839 @@
+#ifndef LINEIMPL_H
+#define LINEIMPL_H
+
+// Определения шаблонов из line.h. Они в заголовке, чтобы подставляться вместе с приёмником:
+// тогда курсор приёмника живёт в регистрах, а ненужный приёмнику вывод выбрасывается.
+
+#include <cmath>
+#include <cstddef>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LINE_AVX2
+#include <immintrin.h>
+#endif
+
+template <typename T> inline int sgn1(T val) {
+	return (val > 0) - (val < 0);
+}
+
+#define check_curr_point do { ok |= x == line.p2().x() && y == line.p2().y(); } while(0)
+
+// Отрезок нулевой длины — одна точка
+template <typename Sink>
+inline void plotPoint(const QPoint &point, Sink &sink)
+{
+	sink.begin(QLine(point, point));
+	sink.moveTo(point.x(), point.y());
+	sink.plot(point.x(), point.y(), sink.color());
+}
+
+// Цвет с альфа-каналом, как его даёт QColor::setAlphaF(alpha) и QColor::rgba()
+inline QRgb withAlphaF(QRgb rgb, double alpha)
+{
+	return (QRgb(qRound(alpha * 0xffff) >> 8) << 24) | (rgb & RGB_MASK);
+}
+
+// Процедура разложения в растр отрезка по методу цифрового дифференциального анализатора (ЦДА)
+template <typename Sink>
+inline bool dda(const QLine &line, Sink &sink)
+{
+	bool ok = false;
+
+	const int deltaX = line.p2().x() - line.p1().x();
+	const int deltaY = line.p2().y() - line.p1().y();
+
+	int length = qMax(qAbs(deltaX), qAbs(deltaY));
+
+	// Предполагается, что концы отрезка не совпадают
+	if (!length) {
+		plotPoint(line.p1(), sink);
+		return true;
+	}
+
+	sink.begin(line);
+	const QRgb color = sink.color();
+
+	// Полагаем большее из приращений dx или dy равным единице растра
+	const double dx = (double) deltaX / length;
+	const double dy = (double) deltaY / length;
+
+	double xf = line.p1().x();
+	double yf = line.p1().y();
+
+	// Начало основного цикла
+	for (int i = 0; i <= length; ++i) {
+		const int x = qRound(xf);
+		const int y = qRound(yf);
+		check_curr_point;
+		sink.moveTo(x, y);
+		sink.plot(x, y, color);
+		xf += dx;
+		yf += dy;
+	}
+
+	return ok;
+}
+// Анализ отрезков, проведенных из точки (0, 0) в точку (—8, 4) и (8, —4), показывает, что
+// разложенный в растр отрезок лежит по одну сторону от реального и что на одном из концов отрезка
+// появляется лишняя точка, т. е. результат работы алгоритма зависит от ориентации. Следовательно,
+// точность в концевых точках ухудшается. Далее, если вместо взятия целой части использовать
+// округление до ближайшего целого, то результаты снова получатся разными. Таким образом, либо
+// нужно использовать более сложный и более медленный алгоритм, либо надо отступиться от требования
+// максимально точной аппроксимации. Вдобавок предложенный алгоритм имеет тот недостаток, что он
+// использует вещественную арифметику.
+
+inline int gcd(int a, int b)
+{
+	while (b) {
+		const int r = a % b;
+		a = b;
+		b = r;
+	}
+	return a;
+}
+
+// Можно ли заменить dda целочисленным вариантом, не изменив ни одного пиксела.
+//
+// dda округляет сумму x1 + dx + ... + dx, а точное значение x1 + i * deltaX / length — дробь со
+// знаменателем length, поэтому она либо ровно посередине между целыми, либо отстоит от середины
+// не меньше чем на 1 / 2length. Для отрезков короче 2^15 с координатами меньше 2^20 ошибка суммы в
+// double и ошибка формата 32.32 обе меньше 1 / 2length, и округляются они одинаково. Ровно на
+// середину значение попадает, только если length / НОД(deltaX, length) чётно; что тогда даст
+// dda, зависит от накопленной ошибки, и такие отрезки остаются за dda (повторять рядом ту же сумму
+// в double выходит медленнее, чем сам dda).
+inline bool ddaFixedExact(const QLine &line, int deltaX, int deltaY, int length)
+{
+	const int limit = 1 << 20;
+	if (length >= 1 << 15
+	    || qAbs(line.x1()) >= limit || qAbs(line.y1()) >= limit
+	    || qAbs(line.x2()) >= limit || qAbs(line.y2()) >= limit)
+		return false;
+	return (length / gcd(qAbs(deltaX), length)) % 2 && (length / gcd(qAbs(deltaY), length)) % 2;
+}
+
+// ЦДА в целых числах
+//
+// Координаты хранятся в формате 32.32 (целая часть в старших 32 битах) со сдвигом на 1/2, так
+// что округление — это целая часть, а шаг — одно целочисленное сложение. Пикселы те же, что у dda.
+template <typename Sink>
+inline bool ddaFixed(const QLine &line, Sink &sink)
+{
+	bool ok = false;
+
+	const int deltaX = line.p2().x() - line.p1().x();
+	const int deltaY = line.p2().y() - line.p1().y();
+
+	const int length = qMax(qAbs(deltaX), qAbs(deltaY));
+
+	if (!length) {
+		plotPoint(line.p1(), sink);
+		return true;
+	}
+	if (!ddaFixedExact(line, deltaX, deltaY, length))
+		return dda(line, sink);
+
+	sink.begin(line);
+	const QRgb color = sink.color();
+
+	const long long one = 1LL << 32;
+	const long long dx = deltaX * one / length;
+	const long long dy = deltaY * one / length;
+
+	long long xf = line.p1().x() * one + one / 2;
+	long long yf = line.p1().y() * one + one / 2;
+
+	for (int i = 0; i <= length; ++i) {
+		const int x = xf >> 32;
+		const int y = yf >> 32;
+		check_curr_point;
+		sink.moveTo(x, y);
+		sink.plot(x, y, color);
+		xf += dx;
+		yf += dy;
+	}
+
+	return ok;
+}
+
+#ifdef LINE_AVX2
+
+inline bool lineVectorized()
+{
+	static const bool avx2 = __builtin_cpu_supports("avx2");
+	return avx2;
+}
+
+// Основной цикл ddaFixed по 8 пикселов: координаты в формате 32.32 лежат в 64-битных словах,
+// целые части — их старшие половины, которые собираются в один вектор из 8 чисел
+template <typename Sink>
+__attribute__((target("avx2")))
+inline bool ddaAvx2(const QLine &line, Sink &sink, int deltaX, int deltaY, int length)
+{
+	bool ok = false;
+
+	sink.begin(line);
+	const QRgb color = sink.color();
+
+	const long long one = 1LL << 32;
+	const long long dx = deltaX * one / length;
+	const long long dy = deltaY * one / length;
+	const long long x0 = line.p1().x() * one + one / 2;
+	const long long y0 = line.p1().y() * one + one / 2;
+
+	__m256i xLow = _mm256_setr_epi64x(x0, x0 + dx, x0 + 2 * dx, x0 + 3 * dx);
+	__m256i xHigh = _mm256_add_epi64(xLow, _mm256_set1_epi64x(4 * dx));
+	__m256i yLow = _mm256_setr_epi64x(y0, y0 + dy, y0 + 2 * dy, y0 + 3 * dy);
+	__m256i yHigh = _mm256_add_epi64(yLow, _mm256_set1_epi64x(4 * dy));
+	const __m256i stepX = _mm256_set1_epi64x(8 * dx);
+	const __m256i stepY = _mm256_set1_epi64x(8 * dy);
+	const __m256i odd = _mm256_setr_epi32(1, 3, 5, 7, 1, 3, 5, 7);
+
+	alignas(32) int xs[8];
+	alignas(32) int ys[8];
+	for (int i = 0; i <= length; i += 8) {
+		_mm256_store_si256((__m256i *) xs, _mm256_permute2x128_si256(
+			_mm256_permutevar8x32_epi32(xLow, odd), _mm256_permutevar8x32_epi32(xHigh, odd), 0x20));
+		_mm256_store_si256((__m256i *) ys, _mm256_permute2x128_si256(
+			_mm256_permutevar8x32_epi32(yLow, odd), _mm256_permutevar8x32_epi32(yHigh, odd), 0x20));
+
+		xLow = _mm256_add_epi64(xLow, stepX);
+		xHigh = _mm256_add_epi64(xHigh, stepX);
+		yLow = _mm256_add_epi64(yLow, stepY);
+		yHigh = _mm256_add_epi64(yHigh, stepY);
+
+		const int count = qMin(8, length + 1 - i);
+		for (int k = 0; k != count; ++k) {
+			const int x = xs[k];
+			const int y = ys[k];
+			check_curr_point;
+			sink.moveTo(x, y);
+			sink.plot(x, y, color);
+		}
+	}
+
+	return ok;
+}
+
+#endif // LINE_AVX2
+
+// Векторный ЦДА: ddaFixed с AVX2, когда процессор его поддерживает
+template <typename Sink>
+inline bool ddaSimd(const QLine &line, Sink &sink)
+{
+#ifdef LINE_AVX2
+	const int deltaX = line.p2().x() - line.p1().x();
+	const int deltaY = line.p2().y() - line.p1().y();
+	const int length = qMax(qAbs(deltaX), qAbs(deltaY));
+	if (lineVectorized() && length && ddaFixedExact(line, deltaX, deltaY, length))
+		return ddaAvx2(line, sink, deltaX, deltaY, length);
+#endif
+	return ddaFixed(line, sink);
+}
+
+// Алгоритм Брезенхема разложения в растр отрезка
+//
+// Алгоритм выбирает оптимальные растровые координаты для представления отрезка. В процессе работы
+// одна из координат — либо x, либо y (в зависимости от углового коэффициента) — изменяется на
+// единицу. Изменение другой координаты (либо на нуль, либо на единицу) зависит от расстояния между
+// действительным положением отрезка и ближайшими координатами сетки. Такое расстояние мы назовем
+// ошибкой.
+template <typename Sink>
+inline bool bresenhamFloat(const QLine &line, Sink &sink)
+{
+	bool ok = false;
+
+	// Предполагается, что концы отрезка не совпадают
+	if (line.p1() == line.p2()) {
+		plotPoint(line.p1(), sink);
+		return true;
+	}
+
+	// Инициализация переменных
+	double x = line.p1().x();
+	double y = line.p1().y();
+	int dx = line.p2().x() - line.p1().x();
+	int dy = line.p2().y() - line.p1().y();
+	const int sx = sgn1(dx);
+	const int sy = sgn1(dy);
+	dx = qAbs(dx);
+	dy = qAbs(dy);
+
+	// обмен значений dx и dy в зависимости от углового коэффициента наклона отрезка
+	const bool swapped = dy > dx;
+	if (swapped)
+		qSwap(dx, dy);
+
+	const double m = static_cast<double>(dy) / dx;
+
+	// Инициализация e с поправкой на половину пиксела
+	double e = m - 0.5;
+
+	// Курсор в растре сдвигается на ±1 по x и на ±pitch по y
+	sink.begin(line);
+	sink.moveTo(x, y);
+	const QRgb color = sink.color();
+	const std::ptrdiff_t stepX = sx;
+	const std::ptrdiff_t stepY = sy * sink.pitch();
+
+	// Начало основного цикла
+	for (int i = 0; i <= dx; ++i) {
+		check_curr_point;
+		sink.plot(x, y, color);
+		if (e >= 0.0) {
+			if (swapped) {
+				x += sx;
+				sink.move(stepX);
+			}
+			else {
+				y += sy;
+				sink.move(stepY);
+			}
+			--e;
+		}
+		if (e < 0) {
+			if (swapped) {
+				y += sy;
+				sink.move(stepY);
+			}
+			else {
+				x += sx;
+				sink.move(stepX);
+			}
+			e += m;
+		}
+	}
+
+	return ok;
+}
+
+// Целочисленный алгоритм Брезенхема
+template <typename Sink>
+inline bool bresenhamInteger(const QLine &line, Sink &sink)
+{
+	bool ok = false;
+
+	// Предполагается, что концы отрезка не совпадают
+	if (line.p1() == line.p2()) {
+		plotPoint(line.p1(), sink);
+		return true;
+	}
+
+	// Инициализация переменных
+	int x = line.p1().x();
+	int y = line.p1().y();
+	int dx = line.p2().x() - line.p1().x();
+	int dy = line.p2().y() - line.p1().y();
+	const int sx = sgn1(dx);
+	const int sy = sgn1(dy);
+	dx = qAbs(dx);
+	dy = qAbs(dy);
+
+	// обмен значений dx и dy в зависимости от углового коэффициента наклона отрезка
+	const bool swapped = dy > dx;
+	if (swapped)
+		qSwap(dx, dy);
+
+	const int dx2 = 2 * dx;
+	const int dy2 = 2 * dy;
+
+	// Инициализация e с поправкой на половину пиксела
+	int e = dy2 - dx;
+
+	// Курсор в растре сдвигается на ±1 по x и на ±pitch по y
+	sink.begin(line);
+	sink.moveTo(x, y);
+	const QRgb color = sink.color();
+	const std::ptrdiff_t stepX = sx;
+	const std::ptrdiff_t stepY = sy * sink.pitch();
+
+	// Начало основного цикла
+	for (int i = 0; i <= dx; ++i) {
+		check_curr_point;
+		sink.plot(x, y, color);
+		if (e >= 0.0) {
+			if (swapped) {
+				x += sx;
+				sink.move(stepX);
+			}
+			else {
+				y += sy;
+				sink.move(stepY);
+			}
+			e -= dx2;
+		}
+		if (e < 0) {
+			if (swapped) {
+				y += sy;
+				sink.move(stepY);
+			}
+			else {
+				x += sx;
+				sink.move(stepX);
+			}
+			e += dy2;
+		}
+	}
+
+	return ok;
+}
+
+// Алгоритм Брезенхема с построением серий
+//
+// При |dy| <= |dx| пикселы отрезка идут горизонтальными сериями (при |dy| > |dx| — вертикальными).
+// Все серии, кроме первой и последней, содержат q = dx / dy или q + 1 пикселов, и длина очередной
+// серии определяется одним сравнением вместо решения на каждом пикселе. Пусть f — ошибка
+// целочисленного алгоритма на последнем пикселе серии, 0 <= f < 2dy, и 2dx = q * 2dy + r. Тогда
+// следующая серия длиннее на пиксел, если f < r, и ошибка на её последнем пикселе равна
+// f - r + 2dy, иначе f - r. Пикселы те же, что у bresenhamInteger.
+template <typename Sink>
+inline bool bresenhamRunSlice(const QLine &line, Sink &sink)
+{
+	if (line.p1() == line.p2()) {
+		plotPoint(line.p1(), sink);
+		return true;
+	}
+
+	int x = line.p1().x();
+	int y = line.p1().y();
+	int dx = line.p2().x() - line.p1().x();
+	int dy = line.p2().y() - line.p1().y();
+	const int sx = sgn1(dx);
+	const int sy = sgn1(dy);
+	dx = qAbs(dx);
+	dy = qAbs(dy);
+
+	const bool swapped = dy > dx;
+	if (swapped)
+		qSwap(dx, dy);
+
+	// Шаг вдоль серии и шаг от серии к серии
+	const int runX = swapped ? 0 : sx;
+	const int runY = swapped ? sy : 0;
+	const int nextX = swapped ? sx : 0;
+	const int nextY = swapped ? 0 : sy;
+
+	sink.begin(line);
+	const QRgb color = sink.color();
+
+	int remaining = dx + 1;
+	int length = remaining;
+	int f = 0;
+	const int dy2 = 2 * dy;
+	const int q = dy ? dx / dy : 0;
+	const int r = dy ? 2 * (dx % dy) : 0;
+	if (dy) {
+		// Первая серия длится, пока ошибка целочисленного алгоритма e = 2dy - dx + 2dy * i отрицательна
+		const int e = dy2 - dx;
+		length = e >= 0 ? 1 : 1 + (dy2 - 1 - e) / dy2;
+		f = e + (length - 1) * dy2;
+	}
+
+	for (;;) {
+		length = qMin(length, remaining);
+		sink.run(x, y, runX, runY, length, color);
+		remaining -= length;
+		if (!remaining)
+			break;
+
+		x += length * runX + nextX;
+		y += length * runY + nextY;
+		if (f < r) {
+			length = q + 1;
+			f += dy2 - r;
+		}
+		else {
+			length = q;
+			f -= r;
+		}
+	}
+
+	// Последний пиксел серии
+	x += (length - 1) * runX;
+	y += (length - 1) * runY;
+	return x == line.p2().x() && y == line.p2().y();
+}
+
+// Алгоритм Брезенхема по готовым шаблонам
+//
+// Для отрезков не длиннее LinePatterns::LENGTH решения алгоритма берутся из таблицы: шаг курсора
+// после пиксела i — шаг по основной оси плюс бит i маски, умноженный на шаг по второй, и в цикле
+// нет ни одного ветвления по данным. Длинные отрезки строит bresenhamRunSlice. Пикселы те же,
+// что у bresenhamInteger.
+template <typename Sink>
+inline bool bresenhamPattern(const QLine &line, Sink &sink)
+{
+	if (line.p1() == line.p2()) {
+		plotPoint(line.p1(), sink);
+		return true;
+	}
+
+	int x = line.p1().x();
+	int y = line.p1().y();
+	int dx = line.p2().x() - line.p1().x();
+	int dy = line.p2().y() - line.p1().y();
+	const int sx = sgn1(dx);
+	const int sy = sgn1(dy);
+	dx = qAbs(dx);
+	dy = qAbs(dy);
+
+	const bool swapped = dy > dx;
+	if (swapped)
+		qSwap(dx, dy);
+	if (dx > LinePatterns::LENGTH)
+		return bresenhamRunSlice(line, sink);
+
+	// Шаг по основной оси и по второй
+	const int majorX = swapped ? 0 : sx;
+	const int majorY = swapped ? sy : 0;
+	const int minorX = swapped ? sx : 0;
+	const int minorY = swapped ? 0 : sy;
+
+	sink.begin(line);
+	sink.moveTo(x, y);
+	const QRgb color = sink.color();
+	const std::ptrdiff_t stepMajor = majorX + majorY * sink.pitch();
+	const std::ptrdiff_t stepMinor = minorX + minorY * sink.pitch();
+
+	quint64 steps = LinePatterns::table.steps(dx, dy);
+	for (int i = 0; i <= dx; ++i, steps >>= 1) {
+		sink.plot(x, y, color);
+		const int step = steps & 1;
+		x += majorX + step * minorX;
+		y += majorY + step * minorY;
+		sink.move(stepMajor + step * stepMinor);
+	}
+
+	// После последнего пиксела курсор сделал лишний шаг по основной оси
+	return x - majorX == line.p2().x() && y - majorY == line.p2().y();
+}
+
+// Два шага целочисленного алгоритма Брезенхема по одной ошибке e: меняется ли вторая координата
+// на первом (first) и на втором (second) шаге. При 2dy <= dx она меняется не больше одного раза
+// за два шага, при 2dy > dx — не меньше одного. Одно сравнение с edge (-2dy или 2dx - 2dy)
+// отделяет однозначный шаблон — оба шага прямые или оба диагональные, — и только иначе второе
+// сравнение, с нулём, выбирает, который из двух шагов диагональный.
+inline void doubleStepPattern(int e, bool steep, int edge, int &first, int &second)
+{
+	if ((e >= edge) == steep) {
+		first = steep;
+		second = steep;
+	}
+	else {
+		first = e >= 0;
+		second = !first;
+	}
+}
+
+// Симметричный алгоритм с двойным шагом (Ву и Рокне)
+//
+// Отрезок строится одновременно с обоих концов к середине, и каждое решение даёт два пиксела:
+// шаблон из двух шагов выбирается одним сравнением, а вторым — только если в нём ровно один
+// диагональный шаг (doubleStepPattern). На итерацию приходится четыре пиксела, по два с каждого
+// конца.
+//
+// Ошибка front — та же e, что у bresenhamInteger, так что пикселы от начала те же. С конца
+// отрезок выглядит так же, только ровно на середине между пикселами (e == 0) bresenhamInteger
+// шагает вперёд по отрезку, то есть для второй половины — назад. Поэтому у неё своя ошибка
+// back = front - 1: с теми же сравнениями она на середине не шагает, и пикселы совпадают с
+// bresenhamInteger на всём отрезке.
+template <typename Sink>
+inline bool bresenhamDoubleStep(const QLine &line, Sink &sink)
+{
+	if (line.p1() == line.p2()) {
+		plotPoint(line.p1(), sink);
+		return true;
+	}
+
+	int x = line.p1().x();
+	int y = line.p1().y();
+	int dx = line.p2().x() - line.p1().x();
+	int dy = line.p2().y() - line.p1().y();
+	const int sx = sgn1(dx);
+	const int sy = sgn1(dy);
+	dx = qAbs(dx);
+	dy = qAbs(dy);
+
+	const bool swapped = dy > dx;
+	if (swapped)
+		qSwap(dx, dy);
+
+	const int majorX = swapped ? 0 : sx;
+	const int majorY = swapped ? sy : 0;
+	const int minorX = swapped ? sx : 0;
+	const int minorY = swapped ? 0 : sy;
+
+	sink.begin(line);
+	const QRgb color = sink.color();
+	const std::ptrdiff_t stepMajor = majorX + majorY * sink.pitch();
+	const std::ptrdiff_t stepMinor = minorX + minorY * sink.pitch();
+
+	const int dx2 = 2 * dx;
+	const int dy2 = 2 * dy;
+	const bool steep = dy2 > dx;
+	const int edge = steep ? dx2 - dy2 : -dy2;
+	int front = dy2 - dx;
+	int back = front - 1;
+	int xBack = line.p2().x();
+	int yBack = line.p2().y();
+	// Последний шаг от начала менял вторую координату
+	int last = 0;
+
+	// Курсор один и после каждого пиксела сдвигается один раз: между половинами он переходит
+	// через gap — смещение текущего пиксела конца от текущего пиксела начала в растре
+	sink.moveTo(x, y);
+	std::ptrdiff_t gap = dx * stepMajor + dy * stepMinor;
+
+	for (int k = (dx + 1) / 4; k; --k) {
+		int first, second, firstBack, secondBack;
+		doubleStepPattern(front, steep, edge, first, second);
+		doubleStepPattern(back, steep, edge, firstBack, secondBack);
+		front += 2 * dy2 - dx2 * (first + second);
+		back += 2 * dy2 - dx2 * (firstBack + secondBack);
+		last = second;
+
+		const std::ptrdiff_t step1 = stepMajor + first * stepMinor;
+		const std::ptrdiff_t step2 = stepMajor + second * stepMinor;
+		const std::ptrdiff_t stepBack1 = stepMajor + firstBack * stepMinor;
+		const std::ptrdiff_t stepBack2 = stepMajor + secondBack * stepMinor;
+
+		sink.plot(x, y, color);
+		sink.move(step1);
+		sink.plot(x + majorX + first * minorX, y + majorY + first * minorY, color);
+		sink.move(gap - step1);
+		sink.plot(xBack, yBack, color);
+		sink.move(-stepBack1);
+		xBack -= majorX + firstBack * minorX;
+		yBack -= majorY + firstBack * minorY;
+		sink.plot(xBack, yBack, color);
+		sink.move(step1 + step2 - gap + stepBack1);
+
+		x += 2 * majorX + (first + second) * minorX;
+		y += 2 * majorY + (first + second) * minorY;
+		xBack -= majorX + secondBack * minorX;
+		yBack -= majorY + secondBack * minorY;
+		gap -= step1 + step2 + stepBack1 + stepBack2;
+	}
+
+	// Оставшиеся посередине (dx + 1) % 4 пикселов — одиночными шагами от начала
+	for (int k = (dx + 1) % 4; k; --k) {
+		sink.plot(x, y, color);
+		last = front >= 0;
+		front += dy2 - dx2 * last;
+		x += majorX + last * minorX;
+		y += majorY + last * minorY;
+		sink.move(stepMajor + last * stepMinor);
+	}
+
+	// Половины сходятся: последний пиксел от начала стоит там, куда шагнула бы вторая половина,
+	// а без неё это конец отрезка
+	return x - majorX - last * minorX == xBack && y - majorY - last * minorY == yBack;
+}
+
+template <typename Sink>
+inline bool bresenhamAntialiased(const QLine &line, Sink &sink)
+{
+	bool ok = false;
+
+	if (line.p1() == line.p2()) {
+		plotPoint(line.p1(), sink);
+		return true;
+	}
+
+	const int i_max = 255;
+	int dx = line.p2().x() - line.p1().x();
+	int dy = line.p2().y() - line.p1().y();
+	int sx = sgn1(dx);
+	int sy = sgn1(dy);
+	dx = qAbs(dx);
+	dy = qAbs(dy);
+	double x = line.p1().x();
+	double y = line.p1().y();
+
+	const bool swapped = dy > dx;
+	if (swapped)
+		qSwap(dx, dy);
+
+	double m = 0;
+	if (dy)
+		m = static_cast<double>(i_max * dy) / dx;
+
+	// В качестве ошибки в данном алгоритме принимается часть площади пиксела, находящаяся под отрезком
+	// Все величины умножены на максимальный уровень интенсивности
+	double e = i_max / 2.0;
+	double w = i_max - m;
+
+	sink.begin(line, 1);
+	sink.moveTo(x, y);
+	const std::ptrdiff_t stepX = sx;
+	const std::ptrdiff_t stepY = sy * sink.pitch();
+	// Интенсивность задаётся альфа-каналом, цвет остаётся прежним
+	const QRgb rgb = sink.color() & RGB_MASK;
+	for (int i = 0; i <= dx; ++i) {
+		check_curr_point;
+		sink.plot(x, y, rgb | (QRgb(int(i_max - e)) << 24));
+		if (e <= w) {
+			if (swapped) {
+				y += sy;
+				sink.move(stepY);
+			}
+			else {
+				x += sx;
+				sink.move(stepX);
+			}
+			// Если ордината соседнего пиксела не увеличивается, то площадь, находящаяся под отрезком, увеличивается на величину
+			// площади прямоугольника со сторонами 1 и m, то есть e = e + m
+			e += m;
+		}
+		// Если же ордината соседнего пиксела увеличивается на единицу, то вычисленная доля площади пиксела будет содержать
+		// и площадь пиксела, через который отрезок не проходит, следовательно, необходимо вычесть величину площади пиксела
+		// Поскольку доля площади не может быть отрицательной величиной, то по сравнению с ранее рассмотренными алгоритмами
+		// Брезенхема необходимо скорректировать величину ошибки, прибавив к ней величину w = 1 - m.
+		else {
+			x += sx;
+			y += sy;
+			sink.move(stepX + stepY);
+			e -= w;
+		}
+	}
+
+	return ok;
+}
+
+inline int ipart(double x) { return floor(x); }
+inline double fpart(double x) { return x - floor(x); }
+inline double rfpart(double x) { return 1 - fpart(x); }
+
+template <typename Sink>
+inline bool wu(const QLine &line, Sink &sink)
+{
+	if (line.p1() == line.p2()) {
+		plotPoint(line.p1(), sink);
+		return true;
+	}
+
+	int x1 = line.p1().x();
+	int y1 = line.p1().y();
+	int x2 = line.p2().x();
+	int y2 = line.p2().y();
+
+	int dx = x2 - x1;
+	int dy = y2 - y1;
+
+	const bool swapped = qAbs(dx) < qAbs(dy);
+	if (swapped) {
+		qSwap(x1, y1);
+		qSwap(x2, y2);
+		qSwap(dx, dy);
+	}
+	if (x2 < x1) {
+		qSwap(x1, x2);
+		qSwap(y1, y2);
+	}
+
+	dx = x2 - x1;
+	dy = y2 - y1;
+	double grad = dx ? static_cast<double>(dy) / dx : 1;
+
+	sink.begin(line, 1);
+	const QRgb color = sink.color();
+	// Шаг курсора поперёк основной оси
+	const std::ptrdiff_t stepMinor = swapped ? 1 : sink.pitch();
+
+	double y = y1;
+	for (int x = x1; x <= x2; ++x) {
+		const int s = sgn1(y);
+		const int iy = ipart(y);
+		const QRgb near = withAlphaF(color, rfpart(y));
+		const QRgb far = withAlphaF(color, fpart(y));
+		if (swapped) {
+			sink.moveTo(iy, x);
+			sink.plot(iy, x, near);
+			sink.move(s * stepMinor);
+			sink.plot(iy + s, x, far);
+		}
+		else {
+			sink.moveTo(x, iy);
+			sink.plot(x, iy, near);
+			sink.move(s * stepMinor);
+			sink.plot(x, iy + s, far);
+		}
+		y += grad;
+	}
+
+	return true;
+}
+
+// Алгоритм Ву в целых числах
+//
+// Ордината хранится в формате 32.32, старшие 8 бит дробной части — интенсивность дальнего
+// пиксела, дополнение до 255 — ближнего. Интенсивность переводится в вес по таблице, и пикселы
+// смешиваются с тем, что уже есть в изображении, а не затирают его.
+template <typename Sink>
+inline bool wuInteger(const QLine &line, Sink &sink, const BlendTable &table)
+{
+	if (line.p1() == line.p2()) {
+		plotPoint(line.p1(), sink);
+		return true;
+	}
+
+	int x1 = line.p1().x();
+	int y1 = line.p1().y();
+	int x2 = line.p2().x();
+	int y2 = line.p2().y();
+
+	const bool swapped = qAbs(x2 - x1) < qAbs(y2 - y1);
+	if (swapped) {
+		qSwap(x1, y1);
+		qSwap(x2, y2);
+	}
+	if (x2 < x1) {
+		qSwap(x1, x2);
+		qSwap(y1, y2);
+	}
+
+	const long long one = 1LL << 32;
+	const long long grad = (y2 - y1) * one / (x2 - x1);
+
+	sink.begin(line, 1);
+	const QRgb color = sink.color();
+	// |grad| <= 1, так что ближний пиксел смещается поперёк основной оси не больше чем на 1
+	const std::ptrdiff_t stepMajor = swapped ? sink.pitch() : 1;
+	const std::ptrdiff_t stepMinor = swapped ? 1 : sink.pitch();
+
+	long long y = y1 * one;
+	int iy = y1;
+	if (swapped)
+		sink.moveTo(iy, x1);
+	else
+		sink.moveTo(x1, iy);
+	for (int x = x1; x <= x2; ++x) {
+		const int far = (y >> 24) & 0xff;
+		if (swapped) {
+			sink.blend(iy, x, color, table.weight[255 - far]);
+			sink.move(stepMinor);
+			sink.blend(iy + 1, x, color, table.weight[far]);
+		}
+		else {
+			sink.blend(x, iy, color, table.weight[255 - far]);
+			sink.move(stepMinor);
+			sink.blend(x, iy + 1, color, table.weight[far]);
+		}
+
+		y += grad;
+		const int next = y >> 32;
+		sink.move(stepMajor + (next - iy - 1) * stepMinor);
+		iy = next;
+	}
+
+	return true;
+}
+
+template <typename Sink>
+inline bool wuInteger(const QLine &line, Sink &sink)
+{
+	return wuInteger(line, sink, BlendTable::linear);
+}
+
+#undef check_curr_point
+
+#endif // LINEIMPL_H
@@ -4,9 +4,11 @@
 #include <QColorDialog>
 #include <QElapsedTimer>
 #include <cmath>
+#include <memory>
 
 #include "line.h"
 #include "dialog.h"
+#include "comparisondialog.h"
 
 MainWindow::MainWindow(QWidget *parent) :
 	QMainWindow(parent),
@@ -61,29 +63,67 @@ void MainWindow::on_setBGColorToFGPushButton_clicked()
 bool MainWindow::drawLine(const QLine &line, Canvas &canvas) {
 	if (ui->ddaRadioButton->isChecked())
 		return dda(line, canvas);
+	else if (ui->ddaFixedRadioButton->isChecked())
+		return ddaFixed(line, canvas);
+	else if (ui->ddaSimdRadioButton->isChecked())
+		return ddaSimd(line, canvas);
 	else if (ui->bresenhamFloatRadioButton->isChecked())
 		return bresenhamFloat(line, canvas);
 	else if (ui->bresenhamIntegerRadioButton->isChecked())
 		return bresenhamInteger(line, canvas);
+	else if (ui->bresenhamRunSliceRadioButton->isChecked())
+		return bresenhamRunSlice(line, canvas);
+	else if (ui->bresenhamPatternRadioButton->isChecked())
+		return bresenhamPattern(line, canvas);
+	else if (ui->bresenhamDoubleStepRadioButton->isChecked())
+		return bresenhamDoubleStep(line, canvas);
 	else if (ui->bresenhamAntialiasedRadioButton->isChecked())
 		return bresenhamAntialiased(line, canvas);
 	else if (ui->defaultQtRadioButton->isChecked())
 		return defaultQt(line, canvas);
 	else if (ui->wuRadioButton->isChecked())
 		return wu(line, canvas);
+	else if (ui->wuIntegerRadioButton->isChecked())
+		return wuInteger(line, canvas, ui->gammaCheckBox->isChecked() ? BlendTable::corrected : BlendTable::linear);
 	return true;
 }
 
-void MainWindow::drawPoint(const QPoint &point)
+// Тот же алгоритм для пакетного построения. У стандартного алгоритма Qt его нет, у целочисленного
+// Ву тоже: BinSink только записывает пикселы, а смешивать их нужно с изображением
+BatchAlgorithm MainWindow::batchAlgorithm() const {
+	if (ui->ddaRadioButton->isChecked())
+		return dda;
+	else if (ui->ddaFixedRadioButton->isChecked())
+		return ddaFixed;
+	else if (ui->ddaSimdRadioButton->isChecked())
+		return ddaSimd;
+	else if (ui->bresenhamFloatRadioButton->isChecked())
+		return bresenhamFloat;
+	else if (ui->bresenhamIntegerRadioButton->isChecked())
+		return bresenhamInteger;
+	else if (ui->bresenhamRunSliceRadioButton->isChecked())
+		return bresenhamRunSlice;
+	else if (ui->bresenhamPatternRadioButton->isChecked())
+		return bresenhamPattern;
+	else if (ui->bresenhamDoubleStepRadioButton->isChecked())
+		return bresenhamDoubleStep;
+	else if (ui->bresenhamAntialiasedRadioButton->isChecked())
+		return bresenhamAntialiased;
+	else if (ui->wuRadioButton->isChecked())
+		return wu;
+	return nullptr;
+}
+
+void MainWindow::drawPoint(const QPoint &point, Canvas &canvas)
 {
-	QPixmap pixmap = QPixmap::fromImage(image);
-	QPainter painter(&pixmap);
+	PainterSession session(canvas);
+	QPainter &painter = *canvas.painter;
+	painter.save();
 	painter.setPen(Qt::red);
 
 	painter.drawEllipse(point, 3, 3);
 
-	painter.end();
-	image = pixmap.toImage();
+	painter.restore();
 }
 
 void MainWindow::on_drawLinePushButton_clicked()
@@ -113,12 +153,39 @@ void MainWindow::on_drawSunPushButton_clicked()
 	int length = ui->lengthSpinBox->text().toInt();
 	int dangle = ui->angleSpinBox->text().toInt();
 	Canvas canvas = { &image, &fgColor };
+
+	QVector<QLine> lines;
 	for (int angle = 0; angle < 360; angle += dangle) {
 		const int x2 = 360 + round(length * cos(toRadians(angle)));
 		const int y2 = 360 - round(length * sin(toRadians(angle)));
-		if (!drawLine(QLine(360, 360, x2, y2), canvas))
-			drawPoint(QPoint(x2, y2));
+		lines.append(QLine(360, 360, x2, y2));
 	}
+
+	QElapsedTimer timer;
+	timer.start();
+
+	// Отметки недостроенных отрезков рисуются поверх всех отрезков, а не между ними
+	if (const BatchAlgorithm algorithm = batchAlgorithm()) {
+		QVector<bool> ok;
+		drawLines(lines, canvas, algorithm, &ok);
+		PainterSession session(canvas);
+		for (int i = 0; i != lines.size(); ++i)
+			if (!ok[i])
+				drawPoint(lines[i].p2(), canvas);
+	}
+	else {
+		// Стандартный алгоритм рисует все отрезки одним QPainter; остальные пишут в изображение
+		// сами, и сеанс для них открывается только ради отметок
+		std::unique_ptr<PainterSession> session;
+		if (ui->defaultQtRadioButton->isChecked())
+			session.reset(new PainterSession(canvas));
+		for (const QLine &line : lines)
+			if (!drawLine(line, canvas))
+				drawPoint(line.p2(), canvas);
+	}
+
+	ui->statusBar->showMessage(QString::number(timer.nsecsElapsed() / 1000.0) + " μs");
+
 	imageView();
 }
 
@@ -135,62 +202,16 @@ void MainWindow::on_setDefaultFGColorPushButton_clicked()
 	colorLabel(ui->fgLabel, fgColor);
 }
 
-// TODO: посчитать один разочек, сохранить и вывести
 void MainWindow::on_statisticsPushButton_clicked()
 {
-	const int N = 1000;
-	const int M = 100;
-	double ns[6][M];
-
-	QImage image(721, 721, QImage::Format_ARGB32);
-	image.fill(defaultBgColor);
-	Canvas canvas = { &image, &fgColor };
-
-	bool (*f[7])(const QLine &, Canvas &) = {
-		dda,
-		wu,
-		dda,
-		bresenhamFloat,
-		bresenhamInteger,
-		bresenhamAntialiased,
-		wu
-	};
-
-	for (int i = 0; i != 7; ++i) {
-		for (int j = 1; j != M + 1; ++j) {
-			QElapsedTimer timer;
-			timer.start();
-
-			for (int k = 0; k != N; ++k)
-				f[i](QLine(360, 360, 360 + j, 360 - j), canvas);
-
-			ns[(i > 1? i - 2 : 0)][j - 1] = static_cast<double>(timer.nsecsElapsed()) / N;
-		}
-	}
-
-	{
-		QPixmap pixmap = QPixmap::fromImage(image);
-		QPainter painter(&pixmap);
-		painter.setPen(fgColor);
-		{
-			for (int j = 1; j != M + 1; ++j) {
-				QElapsedTimer timer;
-				timer.start();
-
-				for (int k = 0; k != N; ++k)
-					defaultQtCore(QLine(360, 360, 360 + j, 360 - j), painter);
-
-				ns[5][j - 1] = static_cast<double>(timer.nsecsElapsed()) / N;
-			}
-		}
-		painter.end();
-	}
-
-	QVector<QVector<double>> qns(6);
-	for (int i = 0; i != 6; ++i)
-		std::copy(ns[i], ns[i] + M, std::back_inserter(qns[i]));
+	Dialog dialog(fgColor, this);
+	dialog.setModal(true);
+	dialog.exec();
+}
 
-	Dialog dialog(qns, M);
+void MainWindow::on_comparePushButton_clicked()
+{
+	ComparisonDialog dialog(this);
 	dialog.setModal(true);
 	dialog.exec();
 }
@@ -6,6 +6,7 @@
 #include <QGraphicsScene>
 
 #include "canvas.h"
+#include "linebatch.h"
 
 namespace Ui {
 class MainWindow;
@@ -25,7 +26,8 @@ private:
 	void imageView();
 
 	bool drawLine(const QLine &line, Canvas &canvas);
-	void drawPoint(const QPoint &point);
+	BatchAlgorithm batchAlgorithm() const;
+	void drawPoint(const QPoint &point, Canvas &canvas);
 
 private slots:
 	void on_fgPushButton_clicked();
@@ -35,6 +37,7 @@ private slots:
 	void on_clearAllPushButton_clicked();
 	void on_setDefaultFGColorPushButton_clicked();
 	void on_statisticsPushButton_clicked();
+	void on_comparePushButton_clicked();
 
 private:
 	Ui::MainWindow *ui;
@@ -0,0 +1,200 @@
+#ifndef PIXELSINK_H
+#define PIXELSINK_H
+
+#include <QVector>
+#include <algorithm>
+#include <cstddef>
+#include "canvas.h"
+
+// Приёмники пикселов, на которые параметризованы алгоритмы построения отрезков (line.h).
+//
+// Алгоритм сообщает приёмнику о новом отрезке (begin), ведёт курсор по растру (moveTo и move
+// со смещениями ±1 и ±pitch()) и выводит пиксел (x, y) в позиции курсора (plot). Приёмники без
+// растра возвращают pitch() == 0 и ничего не делают в moveTo и move, так что после подстановки
+// шаблона от вывода остаётся только то, что приёмник действительно делает с пикселом.
+//
+// Серию из count пикселов (x + i * stepX, y + i * stepY) алгоритм выводит одним вызовом run,
+// курсор при этом не используется.
+//
+// blend смешивает пиксел в позиции курсора с цветом в пропорции weight / 256, weight из [0, 256].
+// Приёмники без изображения выводят его как plot с весом в альфа-канале.
+
+// Запись в изображение
+class ImageSink {
+public:
+	explicit ImageSink(Canvas &canvas)
+	{
+		const Pixels pixels = canvas.pixels();
+		bits = pixels.bits;
+		stride = pixels.pitch;
+		width = pixels.width;
+		height = pixels.height;
+		offset = 0;
+		clipped = true;
+		rgb = pixels.color;
+	}
+
+	// Отрезок, пикселы которого могут выходить за изображение на margin
+	void begin(const QLine &line, int margin = 0)
+	{
+		clipped = !(inside(qMin(line.x1(), line.x2()) - margin, qMin(line.y1(), line.y2()) - margin)
+		         && inside(qMax(line.x1(), line.x2()) + margin, qMax(line.y1(), line.y2()) + margin));
+	}
+
+	QRgb color() const { return rgb; }
+	std::ptrdiff_t pitch() const { return stride; }
+
+	void moveTo(int x, int y) { offset = y * stride + x; }
+	void move(std::ptrdiff_t delta) { offset += delta; }
+
+	void plot(int x, int y, QRgb color)
+	{
+		if (!clipped || inside(x, y))
+			bits[offset] = color;
+	}
+
+	void blend(int x, int y, QRgb color, int weight)
+	{
+		if (clipped && !inside(x, y))
+			return;
+		// Каналы по 16 бит в одном 64-битном слове: 00AA00RR00GG00BB
+		const quint64 mask = 0x00ff00ff00ff00ffull;
+		const quint64 src = (color | (quint64(color) << 24)) & mask;
+		const quint64 dst = (bits[offset] | (quint64(bits[offset]) << 24)) & mask;
+		const quint64 mixed = ((src * weight + dst * (256 - weight)) >> 8) & mask;
+		bits[offset] = QRgb(mixed | (mixed >> 24));
+	}
+
+	void run(int x, int y, int stepX, int stepY, int count, QRgb color)
+	{
+		QRgb *first = bits + y * stride + x;
+		const std::ptrdiff_t step = stepY * stride + stepX;
+		if (clipped) {
+			for (int i = 0; i != count; ++i, x += stepX, y += stepY, first += step)
+				if (inside(x, y))
+					*first = color;
+		}
+		else if (step == 1)
+			std::fill(first, first + count, color);
+		else if (step == -1)
+			std::fill(first - count + 1, first + 1, color);
+		else
+			for (int i = 0; i != count; ++i, first += step)
+				*first = color;
+	}
+
+private:
+	bool inside(std::ptrdiff_t x, std::ptrdiff_t y) const
+	{
+		return std::size_t(x) < std::size_t(width) && std::size_t(y) < std::size_t(height);
+	}
+
+	// Поля не типа QRgb: запись пиксела не может их изменить, и они остаются в регистрах
+	QRgb *bits;
+	std::ptrdiff_t stride;
+	std::ptrdiff_t width;
+	std::ptrdiff_t height;
+	std::ptrdiff_t offset;
+	bool clipped;
+	QRgb rgb;
+};
+
+// Только подсчёт пикселов: время построения без вывода
+class CountSink {
+public:
+	explicit CountSink(QRgb color = 0) : count(0), rgb(color) { }
+
+	void begin(const QLine &, int = 0) { }
+
+	QRgb color() const { return rgb; }
+	std::ptrdiff_t pitch() const { return 0; }
+
+	void moveTo(int, int) { }
+	void move(std::ptrdiff_t) { }
+
+	void plot(int, int, QRgb) { ++count; }
+	void blend(int, int, QRgb, int) { ++count; }
+	void run(int, int, int, int, int count, QRgb) { this->count += count; }
+
+	long long count;
+
+private:
+	QRgb rgb;
+};
+
+// Запись пикселов по порядку вывода
+class RecordSink {
+public:
+	struct Plot {
+		int x, y;
+		QRgb color;
+	};
+
+	explicit RecordSink(QRgb color = 0) : rgb(color) { }
+
+	void begin(const QLine &, int = 0) { }
+
+	QRgb color() const { return rgb; }
+	std::ptrdiff_t pitch() const { return 0; }
+
+	void moveTo(int, int) { }
+	void move(std::ptrdiff_t) { }
+
+	void plot(int x, int y, QRgb color) { plots.append({ x, y, color }); }
+
+	void blend(int x, int y, QRgb color, int weight)
+	{
+		plot(x, y, (color & RGB_MASK) | (QRgb(qMin(weight, 255)) << 24));
+	}
+
+	void run(int x, int y, int stepX, int stepY, int count, QRgb color)
+	{
+		for (int i = 0; i != count; ++i, x += stepX, y += stepY)
+			plot(x, y, color);
+	}
+
+	QVector<Plot> plots;
+
+private:
+	QRgb rgb;
+};
+
+// Контрольная сумма пикселов: сумма хешей (x, y, цвет), от порядка вывода не зависит.
+// Сравнивает результаты алгоритмов без изображения; в отличие от CountSink использует все
+// вычисленные координаты и цвета, так что время с ней — время вычислений без записи.
+class ChecksumSink {
+public:
+	explicit ChecksumSink(QRgb color = 0) : sum(0), rgb(color) { }
+
+	void begin(const QLine &, int = 0) { }
+
+	QRgb color() const { return rgb; }
+	std::ptrdiff_t pitch() const { return 0; }
+
+	void moveTo(int, int) { }
+	void move(std::ptrdiff_t) { }
+
+	void plot(int x, int y, QRgb color)
+	{
+		const quint64 key = (quint64(quint32(x)) << 48) ^ (quint64(quint32(y)) << 32) ^ color;
+		sum += (key ^ (key >> 29)) * 0xbf58476d1ce4e5b9ull;
+	}
+
+	void blend(int x, int y, QRgb color, int weight)
+	{
+		plot(x, y, (color & RGB_MASK) | (QRgb(qMin(weight, 255)) << 24));
+	}
+
+	void run(int x, int y, int stepX, int stepY, int count, QRgb color)
+	{
+		for (int i = 0; i != count; ++i, x += stepX, y += stepY)
+			plot(x, y, color);
+	}
+
+	quint64 sum;
+
+private:
+	QRgb rgb;
+};
+
+#endif // PIXELSINK_H
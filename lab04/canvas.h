@@ -2,10 +2,46 @@
 #define CANVAS_H
 
 #include <QImage>
+#include <QPainter>
+#include <memory>
 
 struct Canvas {
 	QImage *image;
 	QColor *color;
+	// QPainter открытого PainterSession, иначе nullptr
+	QPainter *painter;
+};
+
+// Рисование стандартными средствами Qt прямо в изображение холста, без копий в QPixmap и обратно.
+// Пока сеанс открыт, defaultQt рисует все фигуры одним QPainter; вложенный сеанс ничего не делает.
+class PainterSession {
+public:
+	explicit PainterSession(Canvas &canvas)
+		: canvas(canvas)
+		, owner(!canvas.painter)
+	{
+		if (owner) {
+			painter.reset(new QPainter(canvas.image));
+			painter->setPen(*canvas.color);
+			canvas.painter = painter.get();
+		}
+	}
+
+	~PainterSession()
+	{
+		if (owner) {
+			painter->end();
+			canvas.painter = nullptr;
+		}
+	}
+
+private:
+	Q_DISABLE_COPY(PainterSession)
+
+	Canvas &canvas;
+	bool owner;
+	// в куче: холст живёт дольше сеанса и не должен хранить адрес его поля
+	std::unique_ptr<QPainter> painter;
 };
 
 #endif // CANVAS_H
@@ -1,5 +1,5 @@
 #include "circle.h"
-#include "draw4points.h"
+#include "symmetricplotter.h"
 #include <QPainter>
 #include <cmath>
 
@@ -7,28 +7,29 @@ const float EPS = 1e-5;
 
 void canonical(const QPoint &c, const int r, Canvas &canvas)
 {
+	SymmetricPlotter plotter(c, canvas);
 	const int r2 = r*r;
 	const int deltaX = qRound(r / sqrt(2));
 	for (int x = 0; x <= deltaX; ++x) {
 		const int y = qRound(sqrt(r2 - x*x));
-		draw4points(c, x, y, canvas);
-		draw4points(c, y, x, canvas);
+		plotter.plot8(x, y);
 	}
 }
 
 void parametric(const QPoint &c, const int r, Canvas &canvas)
 {
+	SymmetricPlotter plotter(c, canvas);
 	const float dt = 1.0f / r;
 	for (float t = M_PI / 2.0f; t >= -dt / 2.0f; t -= dt) {
 		const int x = qRound(r * cos(t));
 		const int y = qRound(r * sin(t));
-		draw4points(c, x, y, canvas);
-		draw4points(c, y, x, canvas);
+		plotter.plot8(x, y);
 	}
 }
 
 void bresenham(const QPoint &c, const int r, Canvas &canvas)
 {
+	SymmetricPlotter plotter(c, canvas);
 	int x = 0;
 	int y = r;
 
@@ -36,7 +37,7 @@ void bresenham(const QPoint &c, const int r, Canvas &canvas)
 	// d = (x + 1)^2 + (y - 1)^2 - r^2 = 1 + (r - 1)^2 - r^2 = 2(1 - r)
 	int d = 2 * (1 - r);
 	while (y >= 0) {
-		draw4points(c, x, y, canvas);
+		plotter.plot4(x, y);
 
 		if (d < 0) { // пиксел внутри окружности
 			const int d1 = 2 * (d + y) - 1; // lг - lд
@@ -68,12 +69,12 @@ void bresenham(const QPoint &c, const int r, Canvas &canvas)
 
 void midPoint(const QPoint &c, const int r, Canvas &canvas)
 {
+	SymmetricPlotter plotter(c, canvas);
 	int x = 0;
 	int y = r;
 	int d = 1 - r;
 	do {
-		draw4points(c, x, y, canvas);
-		draw4points(c, y, x, canvas);
+		plotter.plot8(x, y);
 
 		++x;
 		if (d < 0) // средняя точка внутри окружности, ближе верхний пиксел, горизонтальный шаг
@@ -87,14 +88,8 @@ void midPoint(const QPoint &c, const int r, Canvas &canvas)
 
 void defaultQt(const QPoint &c, const int r, Canvas &canvas)
 {
-	QPixmap pixmap = QPixmap::fromImage(*canvas.image);
-	QPainter painter(&pixmap);
-	painter.setPen(*canvas.color);
-
-	defaultQtCore(c, r, painter);
-
-	painter.end();
-	*canvas.image = pixmap.toImage();
+	PainterSession session(canvas);
+	defaultQtCore(c, r, *canvas.painter);
 }
 
 void defaultQtCore(const QPoint &c, const int r, QPainter &painter)
@@ -1,8 +0,0 @@
-#ifndef DRAW4POINTS_H
-#define DRAW4POINTS_H
-
-#include "canvas.h"
-
-void draw4points(const QPoint &c, int x, int y, Canvas &canvas);
-
-#endif // DRAW4POINTS_H
@@ -1,10 +1,11 @@
 #include "ellipse.h"
-#include "draw4points.h"
+#include "symmetricplotter.h"
 #include <QPainter>
 #include <cmath>
 
 void canonical(const QPoint &c, const int a, const int b, Canvas &canvas)
 {
+	SymmetricPlotter plotter(c, canvas);
 	const int a2 = a * a;
 	const int b2 = b * b;
 
@@ -12,30 +13,32 @@ void canonical(const QPoint &c, const int a, const int b, Canvas &canvas)
 	const int deltaX = qRound(a2 / sqrt(a2 + b2));
 	for (int x = 0; x <= deltaX; ++x) {
 		const int y = qRound(sqrt(static_cast<float>(a2 - x*x)) * bDivA);
-		draw4points(c, x, y, canvas);
+		plotter.plot4(x, y);
 	}
 
 	const float aDivB = static_cast<float>(a) / b;
 	const int deltaY = qRound(b2 / sqrt(a2 + b2));
 	for (int y = 0; y <= deltaY; ++y) {
 		const int x = qRound(sqrt(static_cast<float>(b2 - y*y)) * aDivB);
-		draw4points(c, x, y, canvas);
+		plotter.plot4(x, y);
 	}
 }
 
 
 void parametric(const QPoint &c, const int a, const int b, Canvas &canvas)
 {
+	SymmetricPlotter plotter(c, canvas);
 	const float dt = 1.0f / qMax(a, b);
 	for (float t = M_PI / 2.0f; t >= -dt / 2.0f; t -= dt) {
 		const int x = qRound(a * cos(t));
 		const int y = qRound(b * sin(t));
-		draw4points(c, x, y, canvas);
+		plotter.plot4(x, y);
 	}
 }
 
 void bresenham(const QPoint &c, const int a, const int b, Canvas &canvas)
 {
+	SymmetricPlotter plotter(c, canvas);
 	int x = 0;
 	int y = b;
 
@@ -45,7 +48,7 @@ void bresenham(const QPoint &c, const int a, const int b, Canvas &canvas)
 	// разность квадратов расстояний от центра окружности эллипса до диагонального пиксела и до идеального эллипса
 	int d = a2 + b2 - 2 * a2 * y;
 	while (y >= 0) {
-		draw4points(c, x, y, canvas);
+		plotter.plot4(x, y);
 		if (d < 0) { // пиксел лежит внутри эллипса
 			const int d1 = 2 * (d + a2 * y) - a2; // lг - lд
 			++x;
@@ -75,6 +78,7 @@ void bresenham(const QPoint &c, const int a, const int b, Canvas &canvas)
 }
 
 void midPoint(const QPoint& c, const int a, const int b, Canvas &canvas) {
+	SymmetricPlotter plotter(c, canvas);
 	const int a2 = a * a;
 	const int b2 = b * b;
 
@@ -84,7 +88,7 @@ void midPoint(const QPoint& c, const int a, const int b, Canvas &canvas) {
 	int f = b2 + a2 * (y - 0.5f) * (y - 0.5) - static_cast<long long>(a2) * b2;
 	const int deltaX = a2 / sqrt(b2 + a2);
 	while (x <= deltaX) {
-		draw4points(c, x, y, canvas);
+		plotter.plot4(x, y);
 
 		++x;
 		if (f > 0) {
@@ -96,7 +100,7 @@ void midPoint(const QPoint& c, const int a, const int b, Canvas &canvas) {
 
 	f += 0.75f * (a2 - b2) - (b2 * x + a2 * y);
 	while (y >= 0){
-		draw4points(c, x, y, canvas);
+		plotter.plot4(x, y);
 
 		--y;
 		if (f < 0) {
@@ -109,14 +113,8 @@ void midPoint(const QPoint& c, const int a, const int b, Canvas &canvas) {
 
 void defaultQt(const QPoint &c, const int a, const int b, Canvas &canvas)
 {
-	QPixmap pixmap = QPixmap::fromImage(*canvas.image);
-	QPainter painter(&pixmap);
-	painter.setPen(*canvas.color);
-
-	defaultQtCore(c, a, b, painter);
-
-	painter.end();
-	*canvas.image = pixmap.toImage();
+	PainterSession session(canvas);
+	defaultQtCore(c, a, b, *canvas.painter);
 }
 
 void defaultQtCore(const QPoint &c, const int a, const int b, QPainter &painter)
@@ -27,15 +27,14 @@ SOURCES += \
         main.cpp \
         mainwindow.cpp \
     circle.cpp \
-    ellipse.cpp \
-    draw4points.cpp
+    ellipse.cpp
 
 HEADERS += \
         mainwindow.h \
     circle.h \
     ellipse.h \
     canvas.h \
-    draw4points.h
+    symmetricplotter.h
 
 FORMS += \
         mainwindow.ui
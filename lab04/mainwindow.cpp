@@ -4,6 +4,7 @@
 #include <QColorDialog>
 #include <QElapsedTimer>
 #include <cmath>
+#include <memory>
 
 #include "circle.h"
 #include "ellipse.h"
@@ -135,9 +136,15 @@ void MainWindow::on_drawCirclesPushButton_clicked()
 	const QPoint center(360, 360);
 	Canvas canvas = { &image, &fgColor };
 
-	for (int i = 0; i != n; ++i) {
-		drawCircle(center, r0, canvas);
-		r0 += dr;
+	// Стандартный алгоритм рисует все окружности одним QPainter, который закрывается до вывода
+	{
+		std::unique_ptr<PainterSession> session;
+		if (ui->defaultQtRadioButton->isChecked())
+			session.reset(new PainterSession(canvas));
+		for (int i = 0; i != n; ++i) {
+			drawCircle(center, r0, canvas);
+			r0 += dr;
+		}
 	}
 
 	imageView();
@@ -152,10 +159,15 @@ void MainWindow::on_drawEllipsesPushButton_clicked()
 	const QPoint center(360, 360);
 	Canvas canvas = { &image, &fgColor };
 
-	for (int i = 0; i != n; ++i) {
-		drawEllipse(center, a, b, canvas);
-		a += dr;
-		b += dr;
+	{
+		std::unique_ptr<PainterSession> session;
+		if (ui->defaultQtRadioButton->isChecked())
+			session.reset(new PainterSession(canvas));
+		for (int i = 0; i != n; ++i) {
+			drawEllipse(center, a, b, canvas);
+			a += dr;
+			b += dr;
+		}
 	}
 
 	imageView();
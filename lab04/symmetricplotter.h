@@ -0,0 +1,82 @@
+#ifndef SYMMETRICPLOTTER_H
+#define SYMMETRICPLOTTER_H
+
+#include "canvas.h"
+
+// Вывод симметричных относительно центра c точек фигуры прямо в пикселы изображения холста
+// (Format_RGB32 или Format_ARGB32).
+//
+// Изображение отсоединяется и цвет упаковывается один раз на фигуру, а не на каждый setPixel,
+// указатели на строки c.y() + y и c.y() - y вычисляются один раз на вызов. Точки на осях и на
+// диагонали совпадают со своими отражениями и выводятся по одному разу. Точки за пределами
+// изображения пропускаются, как у setPixel.
+class SymmetricPlotter {
+public:
+	SymmetricPlotter(const QPoint &c, Canvas &canvas)
+		: bits(reinterpret_cast<QRgb *>(canvas.image->bits()))
+		, pitch(canvas.image->bytesPerLine() / int(sizeof(QRgb)))
+		, width(canvas.image->width())
+		, height(canvas.image->height())
+		, cx(c.x())
+		, cy(c.y())
+		, reachX(qMin(cx, width - 1 - cx))
+		, reachY(qMin(cy, height - 1 - cy))
+		, color(canvas.color->rgb())
+	{ }
+
+	// (c.x() ± x, c.y() ± y)
+	void plot4(int x, int y)
+	{
+		// Все четыре точки внутри изображения, если внутри прямоугольник, который они задают
+		if (qAbs(x) > reachX || qAbs(y) > reachY) {
+			put(cx + x, cy + y);
+			if (x)
+				put(cx - x, cy + y);
+			if (y) {
+				put(cx + x, cy - y);
+				if (x)
+					put(cx - x, cy - y);
+			}
+			return;
+		}
+
+		QRgb *const below = bits + (cy + y) * pitch + cx;
+		QRgb *const above = bits + (cy - y) * pitch + cx;
+		below[x] = color;
+		if (x)
+			below[-x] = color;
+		if (y) {
+			above[x] = color;
+			if (x)
+				above[-x] = color;
+		}
+	}
+
+	// (c.x() ± x, c.y() ± y) и (c.x() ± y, c.y() ± x)
+	void plot8(int x, int y)
+	{
+		plot4(x, y);
+		if (x != y)
+			plot4(y, x);
+	}
+
+private:
+	void put(int x, int y)
+	{
+		if (uint(x) < uint(width) && uint(y) < uint(height))
+			bits[y * pitch + x] = color;
+	}
+
+	QRgb *bits;
+	int pitch;
+	int width;
+	int height;
+	int cx;
+	int cy;
+	// насколько можно отойти от центра по каждой оси, не выйдя из изображения
+	int reachX;
+	int reachY;
+	QRgb color;
+};
+
+#endif // SYMMETRICPLOTTER_H